@@ -2,9 +2,17 @@
 
 #include "definitions.h"
 #include "pch.h"
+#include "FrameStatistics.h"
 
 namespace Yxis
 {
+   namespace Events
+   {
+      class EventRecorder;
+      class EventPlayer;
+   }
+   class FrameClock;
+
    class YX_API Application
    {
    public:
@@ -13,11 +21,36 @@ namespace Yxis
 
       void run();
 
+      // rolling frame times of the main loop, including the time spent in the frame rate limiter
+      FrameStatistics getFrameStatistics() const;
+      // 0 disables the limit, --max-fps=<n> sets the initial value
+      void setFrameRateLimit(const uint32_t framesPerSecond);
+      void setFixedTimestep(const double seconds);
+      double getFixedTimestep() const { return m_fixedTimestep; }
+      // logs the renderer's last frame performance warnings and validation message counters, debug builds only
+      void dumpValidationSummary() const;
+
    protected:
       void exit();
+
+      // called zero or more times per frame with a constant timestep
+      virtual void onFixedUpdate(const double timestep) {}
+      // called once per frame, alpha is how far the simulation is into the next fixed step
+      virtual void onRender(const double alpha) {}
    private:
+      // window, Vulkan instance, device and pipeline cache, partly in parallel, logs the phase timings
+      void startup();
+
       const std::string m_name;
       bool m_running = false;
+
+      std::unique_ptr<FrameClock> m_frameClock;
+      double m_fixedTimestep = 1.0 / 60.0;
+      uint32_t m_frameRateLimit = 0;
+
+      // --record-events=<path> / --replay-events=<path>
+      std::unique_ptr<Events::EventRecorder> m_eventRecorder;
+      std::unique_ptr<Events::EventPlayer> m_eventPlayer;
    };
 }
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+#include <cstring>
+
+namespace Yxis
+{
+   enum class BinaryLogArg : uint8_t
+   {
+      Bool,
+      Int32,
+      UInt32,
+      Int64,
+      UInt64,
+      Float,
+      Double,
+      Pointer,
+   };
+
+   namespace detail
+   {
+      template <typename>
+      inline constexpr bool alwaysFalse = false;
+
+      // argument types are widened to one of the BinaryLogArg representations
+      template <typename T>
+      constexpr auto binaryLogStorage()
+      {
+         using U = std::remove_cvref_t<T>;
+         if constexpr (std::is_same_v<U, bool>)
+            return bool{};
+         else if constexpr (std::is_enum_v<U>)
+            return binaryLogStorage<std::underlying_type_t<U>>();
+         else if constexpr (std::is_floating_point_v<U>)
+         {
+            if constexpr (sizeof(U) <= sizeof(float)) return float{};
+            else return double{};
+         }
+         else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+         {
+            if constexpr (sizeof(U) <= sizeof(int32_t)) return int32_t{};
+            else return int64_t{};
+         }
+         else if constexpr (std::is_integral_v<U>)
+         {
+            if constexpr (sizeof(U) <= sizeof(uint32_t)) return uint32_t{};
+            else return uint64_t{};
+         }
+         else if constexpr (std::is_pointer_v<U> && not std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, char>)
+            return static_cast<const void*>(nullptr);
+         else
+            static_assert(alwaysFalse<T>, "Binary log arguments must be arithmetic, enums or non-string pointers");
+      }
+
+      template <typename T>
+      using BinaryLogStorage = decltype(binaryLogStorage<T>());
+
+      template <typename T>
+      constexpr BinaryLogArg binaryLogArg()
+      {
+         using S = BinaryLogStorage<T>;
+         if constexpr (std::is_same_v<S, bool>) return BinaryLogArg::Bool;
+         else if constexpr (std::is_same_v<S, int32_t>) return BinaryLogArg::Int32;
+         else if constexpr (std::is_same_v<S, uint32_t>) return BinaryLogArg::UInt32;
+         else if constexpr (std::is_same_v<S, int64_t>) return BinaryLogArg::Int64;
+         else if constexpr (std::is_same_v<S, uint64_t>) return BinaryLogArg::UInt64;
+         else if constexpr (std::is_same_v<S, float>) return BinaryLogArg::Float;
+         else if constexpr (std::is_same_v<S, double>) return BinaryLogArg::Double;
+         else return BinaryLogArg::Pointer;
+      }
+   }
+
+   // One per YX_BINLOG call site, constant-initialized so it costs no guard check
+   struct BinaryLogSite
+   {
+      static constexpr uint32_t UNREGISTERED = UINT32_MAX;
+
+      spdlog::level::level_enum level;
+      std::atomic<uint32_t> formatId = UNREGISTERED;
+   };
+
+   // Hot path log channel. The calling thread only copies a format id, a timestamp and the raw
+   // argument bytes into a thread-local ring buffer; a background thread does the formatting and
+   // hands the result to the core logger's sinks. Full buffers drop records instead of blocking.
+   class YX_API BinaryLog
+   {
+   public:
+      static void initialize();
+      static void shutdown();
+      static uint64_t getDroppedCount();
+
+      // format must be a string literal, use the YX_BINLOG macro
+      template <size_t N, typename... Args>
+      static void write(BinaryLogSite& site, const char (&format)[N], const Args&... args)
+      {
+         uint32_t formatId = site.formatId.load(std::memory_order_relaxed);
+         if (formatId == BinaryLogSite::UNREGISTERED)
+         {
+            static constexpr BinaryLogArg argTypes[] = { detail::binaryLogArg<Args>()..., BinaryLogArg::Bool };
+            formatId = registerFormat(site.level, format, argTypes, sizeof...(Args));
+            site.formatId.store(formatId, std::memory_order_relaxed);
+         }
+
+         constexpr uint32_t payloadSize = (0 + ... + static_cast<uint32_t>(sizeof(detail::BinaryLogStorage<Args>)));
+         std::byte* payload = reserve(formatId, payloadSize);
+         if (payload == nullptr)
+            return;
+
+         (encode(payload, args), ...);
+         commit();
+      }
+   private:
+      static uint32_t registerFormat(spdlog::level::level_enum level, const char* format, const BinaryLogArg* argTypes, uint32_t argCount);
+      static std::byte* reserve(uint32_t formatId, uint32_t payloadSize);
+      static void commit();
+
+      template <typename T>
+      static void encode(std::byte*& payload, const T& value)
+      {
+         using S = detail::BinaryLogStorage<T>;
+         const S stored = static_cast<S>(value);
+         std::memcpy(payload, &stored, sizeof(S));
+         payload += sizeof(S);
+      }
+   };
+}
+
+// YX_BINLOG(spdlog::level::info, "frame {} took {}ms", frameIndex, ms);
+#define YX_BINLOG(level, ...) \
+   do { \
+      static ::Yxis::BinaryLogSite yxBinLogSite{ level }; \
+      ::Yxis::BinaryLog::write(yxBinLogSite, __VA_ARGS__); \
+   } while (false)
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+
+namespace Yxis
+{
+   // Engine options passed on the command line as --name or --name=value
+   class YX_API CommandLine
+   {
+   public:
+      static void initialize(int argc, char** argv) noexcept;
+
+      static bool hasOption(const std::string_view name);
+      // value of --name=value, std::nullopt if the option is missing or has no value
+      static std::optional<std::string_view> getOption(const std::string_view name);
+   private:
+      static std::vector<std::string_view> m_arguments;
+   };
+}
\ No newline at end of file
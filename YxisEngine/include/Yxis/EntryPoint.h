@@ -1,12 +1,20 @@
 #pragma once
 
 #include <Yxis/Logger.h>
+#include <Yxis/CommandLine.h>
+#include <Yxis/JobSystem.h>
+#include <Yxis/FrameArena.h>
+#include <Yxis/Profiler.h>
 
 extern Yxis::Application* CreateApplication();
 
 int main(int argc, char** argv)
 {
+   Yxis::CommandLine::initialize(argc, argv);
    Yxis::Logger::initialize();
+   Yxis::Profiler::initialize();
+   Yxis::JobSystem::initialize();
+   Yxis::FrameArena::initialize();
    Yxis::Application* app = CreateApplication();
 
    try 
@@ -16,10 +24,18 @@ int main(int argc, char** argv)
    catch (const std::runtime_error& e)
    {
       YX_CORE_LOGGER->critical(e.what());
+      Yxis::FrameArena::shutdown();
+      Yxis::JobSystem::shutdown();
+      Yxis::Profiler::shutdown();
+      Yxis::Logger::shutdown();
       return -1;
    }
 
    delete app;
+   Yxis::FrameArena::shutdown();
+   Yxis::JobSystem::shutdown();
+   Yxis::Profiler::shutdown();
+   Yxis::Logger::shutdown();
 
    return 0;
 }
\ No newline at end of file
@@ -3,23 +3,126 @@
 #include <Yxis/pch.h>
 #include <Yxis/definitions.h>
 #include <Yxis/Events/IEvent.h>
+#include <Yxis/Events/EventHandler.h>
+#include <Yxis/Events/EventTypeId.h>
+#include <Yxis/Events/EventQueue.h>
+#include <Yxis/Events/PostedEvent.h>
+#include <Yxis/Events/SubscriptionHandle.h>
 
 namespace Yxis::Events
 {
+	// Subscribing and unsubscribing is allowed from inside a handler. Such changes are deferred
+	// until the outermost dispatch returns, so a running dispatch never sees the handler list change.
 	class YX_API EventDispatcher
 	{
 	public:
-		using Handler = std::function<void(const std::shared_ptr<IEvent>&)>;
+		// Callable must accept const EventType& and be trivially copyable (e.g. a lambda capturing `this`)
+		template <typename EventType, typename Callable>
+		static SubscriptionHandle subscribe(Callable&& callable)
+		{
+			static_assert(std::is_base_of_v<IEvent, EventType>, "EventType must be derived from IEvent");
+			return subscribe(getEventTypeId<EventType>(), EventHandler::create<EventType>(std::forward<Callable>(callable)));
+		}
+
+		// subscribes a member function, e.g. subscribe<IKeyboardEvent, &App::onKey>(this)
+		template <typename EventType, auto Method, typename Class>
+		static SubscriptionHandle subscribe(Class* instance)
+		{
+			static_assert(std::is_base_of_v<IEvent, EventType>, "EventType must be derived from IEvent");
+			return subscribe(getEventTypeId<EventType>(), EventHandler::bind<EventType, Method>(instance));
+		}
+
+		// O(1), the last handler of the type is moved into the freed spot,
+		// so handler invocation order is not preserved. Stale handles are ignored.
+		static void unsubscribe(SubscriptionHandle handle);
+
+		// events are passed by reference, so they can live on the stack
+		template <typename EventType>
+		static void dispatch(const EventType& event)
+		{
+			static_assert(std::is_base_of_v<IEvent, EventType>, "EventType must be derived from IEvent");
+			dispatch(getEventTypeId<EventType>(), event);
+		}
+
+		// Queues the event until the next flush() instead of dispatching it right away.
+		// Queued events are coalesced per EventType::coalescePolicy, dispatch() never coalesces.
+		template <typename EventType>
+		static void enqueue(EventType event)
+		{
+			static_assert(std::is_base_of_v<IEvent, EventType>, "EventType must be derived from IEvent");
+			const EventTypeId type = getEventTypeId<EventType>();
+
+			IEventQueue* queue = getQueue(type);
+			if (queue == nullptr)
+				queue = addQueue(type, std::make_unique<EventQueue<EventType>>());
 
+			static_cast<EventQueue<EventType>*>(queue)->push(std::move(event));
+		}
+
+		// Thread-safe and lock-free version of enqueue(), for events produced by worker threads.
+		// Posted events are moved into the per-frame queues by the main thread at the start of flush().
+		// Nodes come from PostedEventPool, the heap is only touched while the pool grows.
 		template <typename EventType>
-		static void subscribe(Handler handler)
+		static void post(EventType event)
 		{
-			static_assert(std::is_base_of_v<IEvent, EventType> && "EventType must be derived from IEvent");
-			m_handlers[typeid(EventType)].emplace_back(handler);
+			static_assert(std::is_base_of_v<IEvent, EventType>, "EventType must be derived from IEvent");
+
+			auto* node = PostedEventPool<EventType>::acquire(std::move(event));
+			node->deliver = [](PostedEvent* posted) {
+				auto* typed = static_cast<PostedEventNode<EventType>*>(posted);
+				enqueue(std::move(typed->event));
+				PostedEventPool<EventType>::release(typed);
+			};
+			postNode(node);
 		}
 
-		static void dispatch(const std::shared_ptr<IEvent>& event);
+		// Dispatches everything queued since the last flush, one event type at a time,
+		// so the order between different event types is not preserved.
+		// Main thread only.
+		static void flush();
 	private:
-		static std::unordered_map<std::type_index, std::vector<Handler>> m_handlers;
+		static constexpr uint32_t NOT_ADDED = UINT32_MAX;
+
+		// handlers are kept dense, slots[i] is the subscription slot owning handlers[i]
+		struct HandlerList
+		{
+			std::vector<EventHandler> handlers;
+			std::vector<uint32_t>     slots;
+		};
+
+		struct Slot
+		{
+			uint32_t    generation = 0;
+			EventTypeId type = 0;
+			uint32_t    index = NOT_ADDED; // into HandlerList
+		};
+
+		struct PendingChange
+		{
+			SubscriptionHandle handle;
+			EventHandler       handler;
+			bool               subscribe;
+		};
+
+		class DispatchScope;
+
+		static void postNode(PostedEvent* node);
+		static SubscriptionHandle subscribe(EventTypeId type, const EventHandler& handler);
+		static void addHandler(SubscriptionHandle handle, const EventHandler& handler);
+		static void removeHandler(SubscriptionHandle handle);
+		static void dispatch(EventTypeId type, const IEvent& event);
+		static IEventQueue* getQueue(EventTypeId type);
+		static IEventQueue* addQueue(EventTypeId type, std::unique_ptr<IEventQueue> queue);
+
+		// both indexed by EventTypeId
+		static std::vector<HandlerList> m_handlers;
+		static std::vector<std::unique_ptr<IEventQueue>> m_queues;
+
+		// generational slot map backing SubscriptionHandle
+		static std::vector<Slot> m_slots;
+		static std::vector<uint32_t> m_freeSlots;
+
+		static std::vector<PendingChange> m_pendingChanges;
+		static uint32_t m_dispatchDepth;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Yxis/pch.h>
+#include <Yxis/Events/IEvent.h>
+
+namespace Yxis::Events
+{
+	// Type-erased event callback. The callable is stored inline (no std::function),
+	// so subscribing and invoking a handler never allocates.
+	class EventHandler
+	{
+	public:
+		static constexpr size_t STORAGE_SIZE = 2 * sizeof(void*);
+
+		template <typename EventType, typename Callable>
+		static EventHandler create(Callable&& callable)
+		{
+			using Functor = std::decay_t<Callable>;
+			static_assert(std::is_invocable_v<const Functor&, const EventType&>, "Handler must be callable with const EventType&");
+			static_assert(sizeof(Functor) <= STORAGE_SIZE && alignof(Functor) <= alignof(void*), "Handler state doesn't fit into inline storage");
+			static_assert(std::is_trivially_copyable_v<Functor> && std::is_trivially_destructible_v<Functor>, "Handler must be trivially copyable (capture pointers, not owning objects)");
+
+			EventHandler handler;
+			new (handler.m_storage) Functor(std::forward<Callable>(callable));
+			handler.m_invoke = [](const void* storage, const IEvent& event) {
+				(*static_cast<const Functor*>(storage))(static_cast<const EventType&>(event));
+			};
+			return handler;
+		}
+
+		template <typename EventType, auto Method, typename Class>
+		static EventHandler bind(Class* instance)
+		{
+			return create<EventType>([instance](const EventType& event) { (instance->*Method)(event); });
+		}
+
+		void operator()(const IEvent& event) const
+		{
+			m_invoke(m_storage, event);
+		}
+	private:
+		using InvokeFn = void(*)(const void*, const IEvent&);
+
+		InvokeFn m_invoke = nullptr;
+		alignas(void*) std::byte m_storage[STORAGE_SIZE];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Yxis/pch.h>
+#include <Yxis/Events/IEvent.h>
+#include <Yxis/Events/EventHandler.h>
+
+namespace Yxis::Events
+{
+	class IEventQueue
+	{
+	public:
+		virtual ~IEventQueue() = default;
+
+		virtual bool empty() const = 0;
+		// runs every handler over the whole batch and clears it
+		virtual void drain(std::span<const EventHandler> handlers) = 0;
+	};
+
+	// Double-buffered queue of a single event type. Events enqueued while the batch is being
+	// drained (e.g. from a handler) go to the other buffer and are delivered on the next flush.
+	// Both buffers keep their capacity, so a steady stream of events doesn't allocate.
+	// Events are merged on push according to EventType::coalescePolicy.
+	template <typename EventType>
+	class EventQueue final : public IEventQueue
+	{
+	public:
+		void push(EventType&& event)
+		{
+			if constexpr (EventType::coalescePolicy == CoalescePolicy::LastWins)
+			{
+				if (not m_pending.empty())
+				{
+					m_pending.back() = std::move(event);
+					return;
+				}
+			}
+			else if constexpr (EventType::coalescePolicy == CoalescePolicy::Accumulate)
+			{
+				if (not m_pending.empty())
+				{
+					m_pending.back().coalesce(event);
+					return;
+				}
+			}
+
+			m_pending.emplace_back(std::move(event));
+		}
+
+		bool empty() const override
+		{
+			return m_pending.empty();
+		}
+
+		void drain(std::span<const EventHandler> handlers) override
+		{
+			std::swap(m_pending, m_draining);
+			for (const auto& handler : handlers)
+			{
+				for (const auto& event : m_draining)
+					handler(event);
+			}
+			m_draining.clear();
+		}
+	private:
+		std::vector<EventType> m_pending;
+		std::vector<EventType> m_draining;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Yxis/pch.h>
+#include <Yxis/definitions.h>
+
+namespace Yxis::Events
+{
+	using EventTypeId = uint32_t;
+
+	namespace detail
+	{
+		// identical in every module built with the same compiler and unique per type, except for types
+		// in anonymous namespaces: those print as "{anonymous}::X" (or similar) in every translation unit
+		template <typename T>
+		constexpr std::string_view typeSignature()
+		{
+#ifdef _MSC_VER
+			return __FUNCSIG__;
+#else
+			return __PRETTY_FUNCTION__;
+#endif
+		}
+
+		template <typename T>
+		constexpr bool isInAnonymousNamespace()
+		{
+			constexpr std::string_view signature = typeSignature<T>();
+			// gcc, clang, msvc
+			return signature.find("{anonymous}") != std::string_view::npos
+				|| signature.find("(anonymous namespace)") != std::string_view::npos
+				|| signature.find("`anonymous-namespace'") != std::string_view::npos;
+		}
+	}
+
+	// Hands out dense event type ids. Ids are keyed by the type signature and owned by
+	// YxisEngine, so client code and the engine agree on them across the shared library boundary.
+	class YX_API EventTypeRegistry
+	{
+	public:
+		static EventTypeId registerType(std::string_view signature);
+		static size_t getTypeCount();
+	};
+
+	// The registry is only consulted on the first call per type (and module), afterwards it's a static load.
+	// Event types can't live in anonymous namespaces, two of them with the same name would share an id.
+	template <typename EventType>
+	EventTypeId getEventTypeId()
+	{
+		static_assert(not detail::isInAnonymousNamespace<EventType>(), "Event types in anonymous namespaces don't get unique ids, use a named namespace");
+		static const EventTypeId id = EventTypeRegistry::registerType(detail::typeSignature<EventType>());
+		return id;
+	}
+}
\ No newline at end of file
@@ -4,9 +4,20 @@
 
 namespace Yxis::Events
 {
+	// How queued events of one type are merged before a flush.
+	// Event types opt in by redeclaring the static coalescePolicy member.
+	enum class CoalescePolicy
+	{
+		None,       // every event is delivered
+		LastWins,   // only the latest event is delivered
+		Accumulate, // events are folded into one with EventType::coalesce(const EventType& next)
+	};
+
 	class YX_API IEvent
 	{
 	public:
+		static constexpr CoalescePolicy coalescePolicy = CoalescePolicy::None;
+
 		virtual ~IEvent() = default;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Yxis/Events/IEvent.h>
+
+namespace Yxis::Events
+{
+	class YX_API IMouseMotionEvent : public IEvent
+	{
+	public:
+		// position is the latest one, deltas are summed up
+		static constexpr CoalescePolicy coalescePolicy = CoalescePolicy::Accumulate;
+
+		IMouseMotionEvent(float x, float y, float deltaX, float deltaY)
+			: x(x), y(y), deltaX(deltaX), deltaY(deltaY) { }
+		virtual ~IMouseMotionEvent() = default;
+
+		void coalesce(const IMouseMotionEvent& next)
+		{
+			x = next.x;
+			y = next.y;
+			deltaX += next.deltaX;
+			deltaY += next.deltaY;
+		}
+
+		float x;
+		float y;
+		float deltaX;
+		float deltaY;
+	};
+}
\ No newline at end of file
@@ -7,6 +7,9 @@ namespace Yxis::Events
 	class IWindowResizedEvent : public IEvent
 	{
 	public:
+		// only the final size of a drag matters
+		static constexpr CoalescePolicy coalescePolicy = CoalescePolicy::LastWins;
+
 		IWindowResizedEvent(uint32_t newWidth, uint32_t newHeight) 
 			: newWidth(newWidth), newHeight(newHeight) {}
 		virtual ~IWindowResizedEvent() = default;
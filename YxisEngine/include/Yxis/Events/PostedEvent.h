@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Yxis/pch.h>
+#include <Yxis/Events/IEvent.h>
+
+namespace Yxis::Events
+{
+	// Intrusive node of the cross-thread post queue
+	struct PostedEvent
+	{
+		// moves the event into the dispatcher's per-frame queue and recycles the node
+		using DeliverFn = void(*)(PostedEvent* node);
+
+		std::atomic<PostedEvent*> next = nullptr;
+		DeliverFn deliver = nullptr;
+	};
+
+	template <typename EventType>
+	struct PostedEventNode final : PostedEvent
+	{
+		PostedEventNode(EventType&& event)
+			: event(std::move(event)) { }
+
+		EventType event;
+	};
+
+	// Recycles the post() nodes of one event type so posting doesn't go through the global heap, which
+	// can lock. flush() hands delivered nodes back on the main thread, a posting thread whose own cache ran dry
+	// takes the whole returned list with one exchange. One pusher and take-all poppers leave no room for ABA.
+	// The heap is only used until the pool covers the most nodes ever in flight, it never shrinks.
+	template <typename EventType>
+	class PostedEventPool
+	{
+	public:
+		using Node = PostedEventNode<EventType>;
+
+		static Node* acquire(EventType&& event)
+		{
+			Cache& cache = t_cache;
+			if (cache.head == nullptr)
+				cache.head = s_returned.head.exchange(nullptr, std::memory_order_acquire);
+
+			void* storage;
+			if (cache.head != nullptr)
+			{
+				storage = cache.head;
+				cache.head = cache.head->next;
+			}
+			else
+				storage = std::allocator<Node>().allocate(1);
+			return new (storage) Node(std::move(event));
+		}
+
+		// main thread only (flush)
+		static void release(Node* node)
+		{
+			std::destroy_at(node);
+			FreeNode* free = new (static_cast<void*>(node)) FreeNode{ s_returned.head.load(std::memory_order_relaxed) };
+			while (not s_returned.head.compare_exchange_weak(free->next, free, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+	private:
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+		static_assert(sizeof(Node) >= sizeof(FreeNode) && alignof(Node) >= alignof(FreeNode));
+
+		static void freeList(FreeNode* head)
+		{
+			while (head != nullptr)
+			{
+				FreeNode* next = head->next;
+				std::allocator<Node>().deallocate(reinterpret_cast<Node*>(head), 1);
+				head = next;
+			}
+		}
+
+		struct Cache
+		{
+			FreeNode* head = nullptr;
+			~Cache() { freeList(head); }
+		};
+
+		struct ReturnedList
+		{
+			std::atomic<FreeNode*> head = nullptr;
+			~ReturnedList() { freeList(head.load()); }
+		};
+
+		static inline thread_local Cache t_cache;
+		static inline ReturnedList s_returned;
+	};
+}
\ No newline at end of file
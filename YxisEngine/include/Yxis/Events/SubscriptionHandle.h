@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Yxis/pch.h>
+
+namespace Yxis::Events
+{
+	// Returned by EventDispatcher::subscribe, pass it to EventDispatcher::unsubscribe.
+	// A handle outlives its subscription safely, stale handles are detected by the generation.
+	struct SubscriptionHandle
+	{
+		static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+		uint32_t slot = INVALID_SLOT;
+		uint32_t generation = 0;
+
+		bool isValid() const { return slot != INVALID_SLOT; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+
+namespace Yxis
+{
+   // Per-frame linear scratch memory. Allocation bumps a pointer in the calling worker's own sub-arena
+   // (no lock, no heap once the blocks have grown), non-worker threads share one locked sub-arena.
+   // Nothing is freed individually: the arena is triple buffered and memory handed out during frame n is
+   // recycled when frame n + FRAME_COUNT begins. The render thread is at most one frame behind the main
+   // thread, so data passed to it through a frame stays valid until it's done with it.
+   // No destructors run, keep it to trivially destructible data or pmr containers of such.
+   class YX_API FrameArena
+   {
+   public:
+      static constexpr uint32_t FRAME_COUNT = 3;
+      // sub-arenas grow in blocks of this size and keep them across frames
+      static constexpr size_t BLOCK_SIZE = 1024 * 1024;
+
+      // after JobSystem::initialize, one sub-arena per worker
+      static void initialize();
+      static void shutdown();
+
+      static void* allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+
+      template <typename T>
+      static T* allocate(const size_t count = 1)
+      {
+         static_assert(std::is_trivially_destructible_v<T>, "Frame arena memory is recycled without running destructors");
+         return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+      }
+
+      // for std::pmr containers, deallocate is a no-op
+      static std::pmr::memory_resource* getMemoryResource();
+      // bytes handed out so far in the current frame, all threads
+      static size_t getBytesAllocated();
+   private:
+      friend class Application;
+
+      static void beginFrame();
+   };
+}
\ No newline at end of file
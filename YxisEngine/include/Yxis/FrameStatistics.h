@@ -0,0 +1,18 @@
+#pragma once
+
+#include "pch.h"
+
+namespace Yxis
+{
+   // Frame times over the last FrameStatistics::WINDOW_SIZE frames, in milliseconds
+   struct FrameStatistics
+   {
+      static constexpr size_t WINDOW_SIZE = 240;
+
+      double minMs = 0.0;
+      double averageMs = 0.0;
+      double p99Ms = 0.0;
+      double maxMs = 0.0;
+      uint32_t frameCount = 0; // samples in the window
+   };
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+#include "KeyCodes.h"
+
+namespace Yxis
+{
+   // values match SDL_BUTTON_*
+   enum class MouseButton : uint32_t
+   {
+      Left = 1,
+      Middle,
+      Right,
+      X1,
+      X2,
+   };
+
+   // Input state snapshot maintained by Application::run while pumping events.
+   // Queries are plain loads, use this instead of subscribing to IKeyboardEvent just to track held keys.
+   class YX_API Input
+   {
+   public:
+      // more keys held at once than this are ignored until one is released
+      static constexpr size_t MAX_HELD_KEYS = 16;
+
+      // key is a KEY_* code, the same one IKeyboardEvent::key carries
+      static bool isKeyDown(const uint32_t key)
+      {
+         const auto end = m_heldKeys.begin() + m_heldKeyCount;
+         return std::find(m_heldKeys.begin(), end, key) != end;
+      }
+      // KEYMOD_* bits
+      static uint32_t getModifiers() { return m_modifiers; }
+
+      static float getMouseX() { return m_mouseX; }
+      static float getMouseY() { return m_mouseY; }
+      // relative motion accumulated over the current frame
+      static float getMouseDeltaX() { return m_mouseDeltaX; }
+      static float getMouseDeltaY() { return m_mouseDeltaY; }
+      static bool isMouseButtonDown(const MouseButton button) { return m_mouseButtons & (1u << (static_cast<uint32_t>(button) - 1)); }
+   private:
+      friend class Application;
+
+      static void beginFrame();
+      static void reset();
+      static void setKey(const uint32_t key, const bool down, const uint32_t modifiers);
+      static void setMouseMotion(const float x, const float y, const float deltaX, const float deltaY);
+      static void setMouseButton(const uint32_t button, const bool down);
+
+      // keycodes aren't dense, a handful of held keys is scanned instead of indexing a bitset
+      static std::array<uint32_t, MAX_HELD_KEYS> m_heldKeys;
+      static uint32_t m_heldKeyCount;
+      static uint32_t m_modifiers;
+      static uint32_t m_mouseButtons;
+      static float m_mouseX;
+      static float m_mouseY;
+      static float m_mouseDeltaX;
+      static float m_mouseDeltaY;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+
+namespace Yxis
+{
+   // Number of jobs still running for a batch. Pass it to JobSystem::run and JobSystem::wait on it;
+   // waiting on a counter inside a job is how dependencies between jobs are expressed.
+   class JobCounter
+   {
+   public:
+      JobCounter() = default;
+      JobCounter(const JobCounter&) = delete;
+      JobCounter& operator=(const JobCounter&) = delete;
+
+      bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+   private:
+      friend class JobSystem;
+
+      std::atomic<uint32_t> m_pending = 0;
+   };
+
+   // Type-erased job, one cache line. The callable is stored inline like Events::EventHandler,
+   // so submitting a job never allocates.
+   struct alignas(64) Job
+   {
+      static constexpr size_t STORAGE_SIZE = 48;
+      using Function = void(*)(const void* storage);
+
+      template <typename Callable>
+      static Job create(Callable&& callable, JobCounter* counter)
+      {
+         using Functor = std::decay_t<Callable>;
+         static_assert(std::is_invocable_v<const Functor&>, "Job must be callable without arguments");
+         static_assert(sizeof(Functor) <= STORAGE_SIZE && alignof(Functor) <= alignof(void*), "Job state doesn't fit into inline storage");
+         static_assert(std::is_trivially_copyable_v<Functor> && std::is_trivially_destructible_v<Functor>, "Job must be trivially copyable (capture pointers, not owning objects)");
+
+         Job job;
+         new (job.storage) Functor(std::forward<Callable>(callable));
+         job.function = [](const void* storage) { (*static_cast<const Functor*>(storage))(); };
+         job.counter = counter;
+         return job;
+      }
+
+      Function function = nullptr;
+      JobCounter* counter = nullptr;
+      alignas(void*) std::byte storage[STORAGE_SIZE];
+   };
+
+   // Work-stealing job system. One worker per hardware thread: the thread that called initialize()
+   // is worker 0 and runs jobs while it waits, the rest are background threads. Every worker owns a
+   // Chase-Lev deque, pushes and pops its own end and steals from the other end of the others'.
+   // Options: --job-workers=<n> (default: hardware threads), --pin-workers (worker i on core i)
+   class YX_API JobSystem
+   {
+   public:
+      // queued jobs per worker, a worker runs further submissions inline until its deque drains
+      static constexpr uint32_t MAX_JOBS_IN_FLIGHT = 4096;
+
+      static void initialize();
+      static void shutdown();
+
+      static uint32_t getWorkerCount();
+      // 0 .. getWorkerCount() - 1 on workers, UINT32_MAX on other threads
+      static uint32_t getWorkerIndex();
+
+      // callable is run once on any worker, counter (optional) is decremented when it returns
+      template <typename Callable>
+      static void run(Callable&& callable, JobCounter* counter = nullptr)
+      {
+         submit(Job::create(std::forward<Callable>(callable), counter));
+      }
+
+      // runs other jobs until the counter drops to zero
+      static void wait(const JobCounter& counter);
+
+      // keeps the counter above zero until the matching release(), for work that finishes outside
+      // of a job body (a coroutine resumed later, a callback). release() is the last access to the counter
+      static void retain(JobCounter& counter);
+      static void release(JobCounter& counter);
+
+      // calls body(i) for every i in [begin, end) and returns when all calls finished
+      // the range is split into roughly 4 chunks per worker, never smaller than minChunkSize
+      template <typename Body>
+      static void parallelFor(const size_t begin, const size_t end, const Body& body, const size_t minChunkSize = 1)
+      {
+         if (begin >= end)
+            return;
+
+         const size_t count = end - begin;
+         const size_t targetChunks = static_cast<size_t>(getWorkerCount()) * 4;
+         const size_t chunkSize = std::max({ minChunkSize, (count + targetChunks - 1) / targetChunks, size_t(1) });
+
+         JobCounter counter;
+         for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize)
+         {
+            const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+            run([&body, chunkBegin, chunkEnd]() {
+               for (size_t i = chunkBegin; i < chunkEnd; i++)
+                  body(i);
+            }, &counter);
+         }
+         wait(counter);
+      }
+   private:
+      static void submit(const Job& job);
+      static void execute(const Job& job);
+      // pops the own deque, then jobs submitted by non-workers, then steals. false if all were empty
+      static bool tryRunJob();
+      static void workerMain(const uint32_t index);
+   };
+}
\ No newline at end of file
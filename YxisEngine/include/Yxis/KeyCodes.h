@@ -0,0 +1,101 @@
+#pragma once
+
+#include "pch.h"
+
+namespace Yxis
+{
+   // Key codes of IKeyboardEvent::key and Input::isKeyDown, values match SDL_Keycode (SDLK_*).
+   // Printable keys are their lowercase character, the rest carry KEY_SCANCODE_MASK.
+   inline constexpr uint32_t KEY_SCANCODE_MASK = 1u << 30;
+
+   inline constexpr uint32_t KEY_RETURN = '\r';
+   inline constexpr uint32_t KEY_ESCAPE = 0x1B;
+   inline constexpr uint32_t KEY_BACKSPACE = '\b';
+   inline constexpr uint32_t KEY_TAB = '\t';
+   inline constexpr uint32_t KEY_SPACE = ' ';
+   inline constexpr uint32_t KEY_DELETE = 0x7F;
+
+   inline constexpr uint32_t KEY_0 = '0';
+   inline constexpr uint32_t KEY_1 = '1';
+   inline constexpr uint32_t KEY_2 = '2';
+   inline constexpr uint32_t KEY_3 = '3';
+   inline constexpr uint32_t KEY_4 = '4';
+   inline constexpr uint32_t KEY_5 = '5';
+   inline constexpr uint32_t KEY_6 = '6';
+   inline constexpr uint32_t KEY_7 = '7';
+   inline constexpr uint32_t KEY_8 = '8';
+   inline constexpr uint32_t KEY_9 = '9';
+
+   inline constexpr uint32_t KEY_A = 'a';
+   inline constexpr uint32_t KEY_B = 'b';
+   inline constexpr uint32_t KEY_C = 'c';
+   inline constexpr uint32_t KEY_D = 'd';
+   inline constexpr uint32_t KEY_E = 'e';
+   inline constexpr uint32_t KEY_F = 'f';
+   inline constexpr uint32_t KEY_G = 'g';
+   inline constexpr uint32_t KEY_H = 'h';
+   inline constexpr uint32_t KEY_I = 'i';
+   inline constexpr uint32_t KEY_J = 'j';
+   inline constexpr uint32_t KEY_K = 'k';
+   inline constexpr uint32_t KEY_L = 'l';
+   inline constexpr uint32_t KEY_M = 'm';
+   inline constexpr uint32_t KEY_N = 'n';
+   inline constexpr uint32_t KEY_O = 'o';
+   inline constexpr uint32_t KEY_P = 'p';
+   inline constexpr uint32_t KEY_Q = 'q';
+   inline constexpr uint32_t KEY_R = 'r';
+   inline constexpr uint32_t KEY_S = 's';
+   inline constexpr uint32_t KEY_T = 't';
+   inline constexpr uint32_t KEY_U = 'u';
+   inline constexpr uint32_t KEY_V = 'v';
+   inline constexpr uint32_t KEY_W = 'w';
+   inline constexpr uint32_t KEY_X = 'x';
+   inline constexpr uint32_t KEY_Y = 'y';
+   inline constexpr uint32_t KEY_Z = 'z';
+
+   inline constexpr uint32_t KEY_F1 = 58 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F2 = 59 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F3 = 60 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F4 = 61 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F5 = 62 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F6 = 63 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F7 = 64 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F8 = 65 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F9 = 66 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F10 = 67 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F11 = 68 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_F12 = 69 | KEY_SCANCODE_MASK;
+
+   inline constexpr uint32_t KEY_INSERT = 73 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_HOME = 74 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_PAGE_UP = 75 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_END = 77 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_PAGE_DOWN = 78 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_RIGHT = 79 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_LEFT = 80 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_DOWN = 81 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_UP = 82 | KEY_SCANCODE_MASK;
+
+   inline constexpr uint32_t KEY_LEFT_CTRL = 224 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_LEFT_SHIFT = 225 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_LEFT_ALT = 226 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_LEFT_GUI = 227 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_RIGHT_CTRL = 228 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_RIGHT_SHIFT = 229 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_RIGHT_ALT = 230 | KEY_SCANCODE_MASK;
+   inline constexpr uint32_t KEY_RIGHT_GUI = 231 | KEY_SCANCODE_MASK;
+
+   // IKeyboardEvent::mod and Input::getModifiers bits, values match SDL_Keymod (SDL_KMOD_*)
+   inline constexpr uint32_t KEYMOD_LEFT_SHIFT = 0x0001;
+   inline constexpr uint32_t KEYMOD_RIGHT_SHIFT = 0x0002;
+   inline constexpr uint32_t KEYMOD_LEFT_CTRL = 0x0040;
+   inline constexpr uint32_t KEYMOD_RIGHT_CTRL = 0x0080;
+   inline constexpr uint32_t KEYMOD_LEFT_ALT = 0x0100;
+   inline constexpr uint32_t KEYMOD_RIGHT_ALT = 0x0200;
+   inline constexpr uint32_t KEYMOD_LEFT_GUI = 0x0400;
+   inline constexpr uint32_t KEYMOD_RIGHT_GUI = 0x0800;
+   inline constexpr uint32_t KEYMOD_SHIFT = KEYMOD_LEFT_SHIFT | KEYMOD_RIGHT_SHIFT;
+   inline constexpr uint32_t KEYMOD_CTRL = KEYMOD_LEFT_CTRL | KEYMOD_RIGHT_CTRL;
+   inline constexpr uint32_t KEYMOD_ALT = KEYMOD_LEFT_ALT | KEYMOD_RIGHT_ALT;
+   inline constexpr uint32_t KEYMOD_GUI = KEYMOD_LEFT_GUI | KEYMOD_RIGHT_GUI;
+}
\ No newline at end of file
@@ -10,8 +10,12 @@ namespace Yxis
       using logger_t = std::shared_ptr<spdlog::logger>;
 
       static void initialize() noexcept; // this function can't throw errors because it gets called before try block
-      static logger_t getClientLogger() noexcept;
-      static logger_t getCoreLogger() noexcept;
+      static void shutdown() noexcept; // drains the async queue (if enabled) and flushes the sinks
+      static uint64_t getDroppedMessageCount() noexcept; // messages lost to a full async queue
+
+      // returned by reference, so logging doesn't touch the shared_ptr refcount
+      static const logger_t& getClientLogger() noexcept { return m_clientLogger; }
+      static const logger_t& getCoreLogger() noexcept { return m_coreLogger; }
    private:
       static bool m_initialized;
       static logger_t m_coreLogger;
@@ -20,4 +24,76 @@ namespace Yxis
 }
 
 #define YX_CORE_LOGGER     ::Yxis::Logger::getCoreLogger()
-#define YX_CLIENT_LOGGER   ::Yxis::Logger::getClientLogger()
\ No newline at end of file
+#define YX_CLIENT_LOGGER   ::Yxis::Logger::getClientLogger()
+
+// Level macros. Levels below YX_LOG_ACTIVE_LEVEL compile to nothing, enabled ones check the
+// runtime level before evaluating their arguments.
+#define YX_LOG_LEVEL_TRACE    0
+#define YX_LOG_LEVEL_DEBUG    1
+#define YX_LOG_LEVEL_INFO     2
+#define YX_LOG_LEVEL_WARN     3
+#define YX_LOG_LEVEL_ERROR    4
+#define YX_LOG_LEVEL_CRITICAL 5
+#define YX_LOG_LEVEL_OFF      6
+
+#ifndef YX_LOG_ACTIVE_LEVEL
+   #ifdef NDEBUG
+      #define YX_LOG_ACTIVE_LEVEL YX_LOG_LEVEL_INFO
+   #else
+      #define YX_LOG_ACTIVE_LEVEL YX_LOG_LEVEL_TRACE
+   #endif
+#endif
+
+#define YX_LOG_IMPL(loggerPtr, level, ...) \
+   do { \
+      ::spdlog::logger& yxLogger = *(loggerPtr); \
+      if (yxLogger.should_log(level)) yxLogger.log(level, __VA_ARGS__); \
+   } while (false)
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_TRACE
+   #define YX_CORE_TRACE(...)      YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::trace, __VA_ARGS__)
+   #define YX_CLIENT_TRACE(...)    YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::trace, __VA_ARGS__)
+#else
+   #define YX_CORE_TRACE(...)      ((void)0)
+   #define YX_CLIENT_TRACE(...)    ((void)0)
+#endif
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_DEBUG
+   #define YX_CORE_DEBUG(...)      YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::debug, __VA_ARGS__)
+   #define YX_CLIENT_DEBUG(...)    YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::debug, __VA_ARGS__)
+#else
+   #define YX_CORE_DEBUG(...)      ((void)0)
+   #define YX_CLIENT_DEBUG(...)    ((void)0)
+#endif
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_INFO
+   #define YX_CORE_INFO(...)       YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::info, __VA_ARGS__)
+   #define YX_CLIENT_INFO(...)     YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::info, __VA_ARGS__)
+#else
+   #define YX_CORE_INFO(...)       ((void)0)
+   #define YX_CLIENT_INFO(...)     ((void)0)
+#endif
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_WARN
+   #define YX_CORE_WARN(...)       YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::warn, __VA_ARGS__)
+   #define YX_CLIENT_WARN(...)     YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::warn, __VA_ARGS__)
+#else
+   #define YX_CORE_WARN(...)       ((void)0)
+   #define YX_CLIENT_WARN(...)     ((void)0)
+#endif
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_ERROR
+   #define YX_CORE_ERROR(...)      YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::err, __VA_ARGS__)
+   #define YX_CLIENT_ERROR(...)    YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::err, __VA_ARGS__)
+#else
+   #define YX_CORE_ERROR(...)      ((void)0)
+   #define YX_CLIENT_ERROR(...)    ((void)0)
+#endif
+
+#if YX_LOG_ACTIVE_LEVEL <= YX_LOG_LEVEL_CRITICAL
+   #define YX_CORE_CRITICAL(...)   YX_LOG_IMPL(YX_CORE_LOGGER, ::spdlog::level::critical, __VA_ARGS__)
+   #define YX_CLIENT_CRITICAL(...) YX_LOG_IMPL(YX_CLIENT_LOGGER, ::spdlog::level::critical, __VA_ARGS__)
+#else
+   #define YX_CORE_CRITICAL(...)   ((void)0)
+   #define YX_CLIENT_CRITICAL(...) ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "definitions.h"
+#include "pch.h"
+
+namespace Yxis
+{
+   // Scoped CPU zones written to per-thread ring buffers (one writer each, no locks) and exported as
+   // Chrome trace-event JSON for chrome://tracing or Perfetto. Zones are only recorded between
+   // beginCapture() and endCapture(), --profile=<path> captures from startup until exit.
+   // Timestamps are nanoseconds on the performance counter the frame clock uses.
+   class YX_API Profiler
+   {
+   public:
+      // zones per thread kept by one capture, older ones are dropped
+      static constexpr uint32_t ZONES_PER_THREAD = 64 * 1024;
+
+      static void initialize();
+      // ends a running capture, writing it out
+      static void shutdown();
+
+      static void beginCapture(const std::string_view path);
+      // writes the zones recorded since beginCapture to its path
+      static void endCapture();
+      static bool isCapturing() noexcept { return m_capturing.load(std::memory_order_relaxed); }
+
+      // shown as the thread's track name, call once from the thread itself
+      static void setThreadName(const std::string_view name);
+
+      // a track for a timeline that isn't a CPU thread (a GPU queue), grouped under process in the trace
+      static uint32_t createTrack(const std::string_view process, const std::string_view name);
+
+      static uint64_t now() noexcept;
+      // a raw SDL_GetPerformanceCounter() value (what FrameClock::now() returns) in now()'s nanoseconds
+      static uint64_t toNanoseconds(const uint64_t performanceCounter) noexcept;
+      // name must outlive the capture, zones keep the pointer
+      static void record(const char* name, const uint64_t begin, const uint64_t end) noexcept;
+      // from any thread, begin and end in now()'s timebase
+      static void recordOnTrack(const uint32_t track, const char* name, const uint64_t begin, const uint64_t end) noexcept;
+   private:
+      static std::atomic<bool> m_capturing;
+   };
+
+   class ProfileScope
+   {
+   public:
+      explicit ProfileScope(const char* name) noexcept
+         : m_name(name), m_begin(Profiler::isCapturing() ? Profiler::now() : 0) { }
+      ~ProfileScope()
+      {
+         // zones straddling the start or the end of a capture are dropped
+         if (m_begin != 0 && Profiler::isCapturing())
+            Profiler::record(m_name, m_begin, Profiler::now());
+      }
+
+      ProfileScope(const ProfileScope&) = delete;
+      ProfileScope& operator=(const ProfileScope&) = delete;
+   private:
+      const char* m_name;
+      const uint64_t m_begin;
+   };
+}
+
+// Zones compile to nothing unless the engine is built with YX_PROFILER (CMake option, on by default)
+#define YX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define YX_PROFILE_CONCAT(a, b) YX_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef YX_PROFILER
+   #define YX_PROFILE_SCOPE(name)   ::Yxis::ProfileScope YX_PROFILE_CONCAT(yxProfileScope, __LINE__)(name)
+   #define YX_PROFILE_FUNCTION()    YX_PROFILE_SCOPE(__func__)
+#else
+   #define YX_PROFILE_SCOPE(name)   ((void)0)
+   #define YX_PROFILE_FUNCTION()    ((void)0)
+#endif
\ No newline at end of file
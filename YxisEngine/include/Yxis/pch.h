@@ -6,4 +6,13 @@
 #include <string>
 #include <functional>
 #include <unordered_map>
-#include <typeindex>
\ No newline at end of file
+#include <typeindex>
+#include <vector>
+#include <span>
+#include <atomic>
+#include <bitset>
+#include <array>
+#include <optional>
+#include <string_view>
+#include <algorithm>
+#include <memory_resource>
\ No newline at end of file
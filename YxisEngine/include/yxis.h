@@ -3,4 +3,9 @@
 #include <Yxis/definitions.h>
 #include <Yxis/Logger.h>
 #include <Yxis/Application.h>
+#include <Yxis/Input.h>
+#include <Yxis/KeyCodes.h>
+#include <Yxis/JobSystem.h>
+#include <Yxis/FrameArena.h>
+#include <Yxis/Profiler.h>
 #include <Yxis/EntryPoint.h>
\ No newline at end of file
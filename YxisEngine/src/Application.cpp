@@ -1,18 +1,45 @@
 #include <Yxis/Application.h>
 #include <Yxis/Logger.h>
+#include <Yxis/Input.h>
+#include <Yxis/CommandLine.h>
+#include <Yxis/FrameArena.h>
+#include <Yxis/JobSystem.h>
+#include <Yxis/Profiler.h>
 #include <Yxis/Events/EventDispatcher.h>
 #include <Yxis/Events/IKeyboardEvent.h>
 #include <Yxis/Events/IWindowResizedEvent.h>
+#include <Yxis/Events/IMouseMotionEvent.h>
+#include "Events/EventRecording.h"
 #include "Vulkan/VulkanRenderer.h"
+#include "Vulkan/RenderThread.h"
+#include "Tasks/TaskTest.h"
 #include "Window.h"
+#include "FrameClock.h"
+#include <charconv>
 
 namespace Yxis
 {
+   // upper bound on how long posted events wait to be flushed while idle
+   static constexpr int32_t IDLE_EVENT_TIMEOUT_MS = 100;
+
+   // --pipeline-cache=<path> overrides it
+   static constexpr std::string_view DEFAULT_PIPELINE_CACHE_PATH = "pipeline.cache";
+
+   // how a startup job went, jobs can't throw
+   struct StartupStage
+   {
+      double milliseconds = 0.0;
+      std::exception_ptr error;
+   };
+
+   static double toMilliseconds(const uint64_t ticks)
+   {
+      return static_cast<double>(ticks) * 1000.0 / static_cast<double>(FrameClock::getFrequency());
+   }
+
    Application::Application(const std::string_view name) noexcept
-      : m_name(name)
+      : m_name(name), m_frameClock(std::make_unique<FrameClock>())
    {
-      volkInitialize();
-      Window::initialize(m_name);
    }
 
    Application::~Application()
@@ -20,31 +47,205 @@ namespace Yxis
       SDL_Quit();
    }
 
+   // SDL stays on the main thread (some platforms insist), the rest runs on jobs next to it:
+   //
+   //   main:  window ----------+-- device --+-- pipeline cache
+   //   job:   instance, gpu ---+            |
+   //   job:   pipeline cache file ----------+
+   void Application::startup()
+   {
+      YX_PROFILE_SCOPE("Application::startup");
+      const uint64_t startupBegin = FrameClock::now();
+      const bool headless = CommandLine::hasOption("headless");
+      const std::string pipelineCachePath(CommandLine::getOption("pipeline-cache").value_or(DEFAULT_PIPELINE_CACHE_PATH));
+
+      JobCounter instanceReady;
+      JobCounter pipelineCacheLoaded;
+      StartupStage instanceStage;
+      StartupStage pipelineCacheStage;
+      std::vector<std::byte> pipelineCacheData;
+
+      // an exception on the main thread mustn't unwind this frame while the jobs still write into it
+      struct WaitForJobs
+      {
+         const JobCounter& instanceReady;
+         const JobCounter& pipelineCacheLoaded;
+         ~WaitForJobs() { JobSystem::wait(instanceReady); JobSystem::wait(pipelineCacheLoaded); }
+      } waitForJobs{ instanceReady, pipelineCacheLoaded };
+
+      JobSystem::run([this, headless, &instanceStage]() {
+         const uint64_t begin = FrameClock::now();
+         try { Vulkan::VulkanRenderer::createInstance(m_name, headless); }
+         catch (...) { instanceStage.error = std::current_exception(); }
+         instanceStage.milliseconds = toMilliseconds(FrameClock::now() - begin);
+      }, &instanceReady);
+
+      JobSystem::run([&pipelineCachePath, &pipelineCacheData, &pipelineCacheStage]() {
+         const uint64_t begin = FrameClock::now();
+         try { pipelineCacheData = Vulkan::PipelineCache::load(pipelineCachePath); }
+         catch (...) { pipelineCacheStage.error = std::current_exception(); }
+         pipelineCacheStage.milliseconds = toMilliseconds(FrameClock::now() - begin);
+      }, &pipelineCacheLoaded);
+
+      uint64_t phaseBegin = FrameClock::now();
+      {
+         YX_PROFILE_SCOPE("Window::initialize");
+         Window::initialize(m_name, headless);
+      }
+      const double windowMs = toMilliseconds(FrameClock::now() - phaseBegin);
+
+      phaseBegin = FrameClock::now();
+      JobSystem::wait(instanceReady);
+      const double instanceWaitMs = toMilliseconds(FrameClock::now() - phaseBegin);
+      if (instanceStage.error)
+         std::rethrow_exception(instanceStage.error);
+
+      phaseBegin = FrameClock::now();
+      Vulkan::VulkanRenderer::createDevice();
+      const double deviceMs = toMilliseconds(FrameClock::now() - phaseBegin);
+
+      phaseBegin = FrameClock::now();
+      JobSystem::wait(pipelineCacheLoaded);
+      if (pipelineCacheStage.error)
+         std::rethrow_exception(pipelineCacheStage.error);
+      Vulkan::VulkanRenderer::createPipelineCache(pipelineCachePath, pipelineCacheData);
+      const double pipelineCacheMs = toMilliseconds(FrameClock::now() - phaseBegin);
+
+      YX_CORE_LOGGER->info("Startup took {:.2f} ms", toMilliseconds(FrameClock::now() - startupBegin));
+      YX_CORE_LOGGER->info("  window {:.2f} ms, in parallel: instance {:.2f} ms, pipeline cache read {:.2f} ms ({} bytes)",
+         windowMs, instanceStage.milliseconds, pipelineCacheStage.milliseconds, pipelineCacheData.size());
+      YX_CORE_LOGGER->info("  waited {:.2f} ms for the instance, device {:.2f} ms, pipeline cache {:.2f} ms",
+         instanceWaitMs, deviceMs, pipelineCacheMs);
+   }
+
    void Application::run()
    {
       // prevent double invoke
       if (m_running) return;
       else m_running = true;
 
-      Vulkan::VulkanRenderer::initialize(m_name);
+      startup();
+
+      if (CommandLine::hasOption("task-test"))
+         Tasks::runTaskTest();
+
+      if (const auto path = CommandLine::getOption("record-events"))
+         m_eventRecorder = std::make_unique<Events::EventRecorder>(path.value());
+      if (const auto path = CommandLine::getOption("replay-events"))
+         m_eventPlayer = std::make_unique<Events::EventPlayer>(path.value());
+      if (const auto option = CommandLine::getOption("max-fps"))
+         std::from_chars(option->data(), option->data() + option->size(), m_frameRateLimit);
+      // benchmark runs, mostly headless where there's no window to close
+      uint64_t maxFrames = 0;
+      if (const auto option = CommandLine::getOption("max-frames"))
+         std::from_chars(option->data(), option->data() + option->size(), maxFrames);
+      uint64_t frameCount = 0;
 
+      // while replaying, live input is thrown away and the recording takes its place
+      auto pollEvent = [this](SDL_Event& event, const int32_t timeoutMs) {
+         if (not m_eventPlayer)
+            return timeoutMs > 0 ? SDL_WaitEventTimeout(&event, timeoutMs) : SDL_PollEvent(&event);
+
+         SDL_PumpEvents();
+         SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+         return m_eventPlayer->poll(event);
+      };
+
+      // submission and present happen there, the loop below only hands frames over
+      std::optional<Vulkan::RenderThread> renderThread(std::in_place);
+
+      m_frameClock->reset();
+      bool idle = false;
       while (m_running)
       {
-         SDL_Event event;
-         while (SDL_PollEvent(&event))
+         YX_PROFILE_SCOPE("Frame");
+
+         // nothing can be presented, so block on events instead of spinning
+         // a replay drives the loop by itself and is never throttled
+         const bool wasIdle = idle;
+         idle = not m_eventPlayer && not Window::isPresentable();
+         if (idle != wasIdle)
+            YX_CORE_LOGGER->info(idle ? "Window not presentable, throttling main loop" : "Window presentable, resuming main loop");
+
+         if (idle)
+            m_frameClock->reset();
+         else
          {
-             if (event.type == SDL_EVENT_QUIT) m_running = false;
-             if (event.type == SDL_EVENT_KEY_DOWN && event.key.repeat == false)
-                 Events::EventDispatcher::dispatch(std::make_shared<Events::IKeyboardEvent>(true, event.key.key, event.key.mod));
-             if (event.type == SDL_EVENT_KEY_UP && event.key.repeat == false)
-                 Events::EventDispatcher::dispatch(std::make_shared<Events::IKeyboardEvent>(false, event.key.key, event.key.mod));
-             if (event.type == SDL_EVENT_WINDOW_RESIZED)
-                 Events::EventDispatcher::dispatch(std::make_shared<Events::IWindowResizedEvent>(event.window.data1, event.window.data2));
+            m_frameClock->beginFrame();
+            FrameArena::beginFrame();
          }
+         Input::beginFrame();
 
-         // render
+         {
+            YX_PROFILE_SCOPE("Application::pollEvents");
+            SDL_Event event;
+            int32_t eventTimeoutMs = idle ? IDLE_EVENT_TIMEOUT_MS : 0;
+            while (pollEvent(event, eventTimeoutMs))
+            {
+                eventTimeoutMs = 0;
+                if (m_eventRecorder) m_eventRecorder->record(event);
+                if (event.type == SDL_EVENT_QUIT) m_running = false;
+                if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP)
+                    Input::setKey(event.key.key, event.type == SDL_EVENT_KEY_DOWN, event.key.mod);
+                if (event.type == SDL_EVENT_KEY_DOWN && event.key.repeat == false)
+                    Events::EventDispatcher::enqueue(Events::IKeyboardEvent(true, event.key.key, event.key.mod));
+                if (event.type == SDL_EVENT_KEY_UP && event.key.repeat == false)
+                    Events::EventDispatcher::enqueue(Events::IKeyboardEvent(false, event.key.key, event.key.mod));
+                if (event.type == SDL_EVENT_WINDOW_RESIZED)
+                    Events::EventDispatcher::enqueue(Events::IWindowResizedEvent(event.window.data1, event.window.data2));
+                if (event.type == SDL_EVENT_WINDOW_FOCUS_LOST)
+                    Input::reset();
+                if (event.type == SDL_EVENT_MOUSE_MOTION)
+                {
+                    Input::setMouseMotion(event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel);
+                    Events::EventDispatcher::enqueue(Events::IMouseMotionEvent(event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel));
+                }
+                if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP)
+                    Input::setMouseButton(event.button.button, event.type == SDL_EVENT_MOUSE_BUTTON_DOWN);
+            }
+         }
+
+         // input is pumped, now let the handlers run
+         Events::EventDispatcher::flush();
+
+         if (m_eventPlayer && m_eventPlayer->finished())
+         {
+            YX_CORE_LOGGER->info("Event replay finished");
+            m_running = false;
+         }
+
+         if (idle)
+            continue;
+
+         while (m_frameClock->consumeFixedStep(m_fixedTimestep))
+         {
+            YX_PROFILE_SCOPE("Application::onFixedUpdate");
+            onFixedUpdate(m_fixedTimestep);
+         }
+
+         {
+            YX_PROFILE_SCOPE("Application::onRender");
+            onRender(m_frameClock->getInterpolationAlpha(m_fixedTimestep));
+         }
+
+         {
+            YX_PROFILE_SCOPE("RenderThread::submitFrame");
+            renderThread->submitFrame({ .frameNumber = frameCount, .drawableExtent = Window::getExtent() });
+         }
+
+         if (++frameCount == maxFrames)
+            m_running = false;
+
+         if (m_frameRateLimit != 0)
+         {
+            YX_PROFILE_SCOPE("FrameClock::waitForFrameEnd");
+            m_frameClock->waitForFrameEnd(1.0 / m_frameRateLimit);
+         }
       }
 
+      renderThread.reset();
+      m_eventRecorder.reset();
+      m_eventPlayer.reset();
       Vulkan::VulkanRenderer::destroy();
    }
 
@@ -52,4 +253,26 @@ namespace Yxis
    {
       m_running = false;
    }
+
+   FrameStatistics Application::getFrameStatistics() const
+   {
+      return m_frameClock->getStatistics();
+   }
+
+   void Application::dumpValidationSummary() const
+   {
+      Vulkan::VulkanRenderer::dumpValidationSummary();
+   }
+
+   void Application::setFrameRateLimit(const uint32_t framesPerSecond)
+   {
+      m_frameRateLimit = framesPerSecond;
+   }
+
+   void Application::setFixedTimestep(const double seconds)
+   {
+      if (seconds <= 0.0)
+         throw std::runtime_error(fmt::format("Invalid fixed timestep {}", seconds));
+      m_fixedTimestep = seconds;
+   }
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <Yxis/CommandLine.h>
+
+namespace Yxis
+{
+   std::vector<std::string_view> CommandLine::m_arguments;
+
+   static bool matchOption(const std::string_view argument, const std::string_view name, std::string_view& value)
+   {
+      if (not argument.starts_with("--") || argument.substr(2, name.size()) != name)
+         return false;
+
+      const std::string_view rest = argument.substr(2 + name.size());
+      if (rest.empty())
+      {
+         value = {};
+         return true;
+      }
+
+      if (rest[0] != '=')
+         return false;
+
+      value = rest.substr(1);
+      return true;
+   }
+
+   void CommandLine::initialize(int argc, char** argv) noexcept
+   {
+      m_arguments.clear();
+      for (int i = 1; i < argc; i++)
+         m_arguments.emplace_back(argv[i]);
+   }
+
+   bool CommandLine::hasOption(const std::string_view name)
+   {
+      std::string_view value;
+      for (const auto argument : m_arguments)
+      {
+         if (matchOption(argument, name, value))
+            return true;
+      }
+
+      return false;
+   }
+
+   std::optional<std::string_view> CommandLine::getOption(const std::string_view name)
+   {
+      std::string_view value;
+      for (const auto argument : m_arguments)
+      {
+         if (matchOption(argument, name, value) && not value.empty())
+            return value;
+      }
+
+      return std::nullopt;
+   }
+}
\ No newline at end of file
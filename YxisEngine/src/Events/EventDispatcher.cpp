@@ -1,16 +1,168 @@
 #include <Yxis/Events/EventDispatcher.h>
+#include <Yxis/Profiler.h>
+#include "MpscQueue.h"
 
 using namespace Yxis::Events;
-using Handler = EventDispatcher::Handler;
 
-std::unordered_map<std::type_index, std::vector<Handler>> EventDispatcher::m_handlers;
+std::vector<EventDispatcher::HandlerList> EventDispatcher::m_handlers;
+std::vector<std::unique_ptr<IEventQueue>> EventDispatcher::m_queues;
+std::vector<EventDispatcher::Slot> EventDispatcher::m_slots;
+std::vector<uint32_t> EventDispatcher::m_freeSlots;
+std::vector<EventDispatcher::PendingChange> EventDispatcher::m_pendingChanges;
+uint32_t EventDispatcher::m_dispatchDepth = 0;
 
-void EventDispatcher::dispatch(const std::shared_ptr<IEvent>& event)
+static MpscQueue<PostedEvent> s_postedEvents;
+
+// Marks a running dispatch, subscription changes made meanwhile are applied when the outermost scope ends
+class EventDispatcher::DispatchScope
+{
+public:
+	DispatchScope()
+	{
+		m_dispatchDepth++;
+	}
+
+	~DispatchScope()
+	{
+		if (--m_dispatchDepth > 0)
+			return;
+
+		for (const auto& change : m_pendingChanges)
+		{
+			if (change.subscribe)
+				addHandler(change.handle, change.handler);
+			else
+				removeHandler(change.handle);
+		}
+		m_pendingChanges.clear();
+	}
+};
+
+SubscriptionHandle EventDispatcher::subscribe(EventTypeId type, const EventHandler& handler)
+{
+	uint32_t slotIndex;
+	if (not m_freeSlots.empty())
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slotIndex = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
+
+	Slot& slot = m_slots[slotIndex];
+	slot.type = type;
+	slot.index = NOT_ADDED;
+
+	const SubscriptionHandle handle{ slotIndex, slot.generation };
+	if (m_dispatchDepth > 0)
+		m_pendingChanges.push_back({ handle, handler, true });
+	else
+		addHandler(handle, handler);
+
+	return handle;
+}
+
+void EventDispatcher::unsubscribe(SubscriptionHandle handle)
+{
+	if (handle.slot >= m_slots.size() || m_slots[handle.slot].generation != handle.generation)
+		return;
+
+	if (m_dispatchDepth > 0)
+		m_pendingChanges.push_back({ handle, EventHandler{}, false });
+	else
+		removeHandler(handle);
+}
+
+void EventDispatcher::addHandler(SubscriptionHandle handle, const EventHandler& handler)
+{
+	Slot& slot = m_slots[handle.slot];
+	if (slot.generation != handle.generation)
+		return;
+
+	if (slot.type >= m_handlers.size())
+		m_handlers.resize(slot.type + 1);
+
+	HandlerList& list = m_handlers[slot.type];
+	slot.index = static_cast<uint32_t>(list.handlers.size());
+	list.handlers.emplace_back(handler);
+	list.slots.emplace_back(handle.slot);
+}
+
+void EventDispatcher::removeHandler(SubscriptionHandle handle)
+{
+	Slot& slot = m_slots[handle.slot];
+	if (slot.generation != handle.generation)
+		return;
+
+	if (slot.index != NOT_ADDED)
+	{
+		// swap with the last handler so the list stays dense
+		HandlerList& list = m_handlers[slot.type];
+		const uint32_t last = static_cast<uint32_t>(list.handlers.size() - 1);
+		list.handlers[slot.index] = list.handlers[last];
+		list.slots[slot.index] = list.slots[last];
+		m_slots[list.slots[slot.index]].index = slot.index;
+		list.handlers.pop_back();
+		list.slots.pop_back();
+	}
+
+	slot.generation++;
+	slot.index = NOT_ADDED;
+	m_freeSlots.emplace_back(handle.slot);
+}
+
+void EventDispatcher::dispatch(EventTypeId type, const IEvent& event)
+{
+	if (type >= m_handlers.size())
+		return;
+
+	YX_PROFILE_SCOPE("EventDispatcher::dispatch");
+	DispatchScope scope;
+	for (const auto& handler : m_handlers[type].handlers)
+		handler(event);
+}
+
+void EventDispatcher::postNode(PostedEvent* node)
+{
+	s_postedEvents.push(node);
+}
+
+void EventDispatcher::flush()
 {
-	auto e = m_handlers.find(typeid(*event));
-	if (e != m_handlers.end())
+	YX_PROFILE_SCOPE("EventDispatcher::flush");
+	// events that are still being pushed get picked up next frame
+	while (PostedEvent* node = s_postedEvents.pop())
+		node->deliver(node);
+
+	DispatchScope scope;
+
+	// a handler may enqueue a new event type and grow m_queues, so index instead of iterating
+	for (EventTypeId type = 0; type < m_queues.size(); type++)
 	{
-		for (auto& handler : e->second)
-			handler(event);
+		IEventQueue* queue = m_queues[type].get();
+		if (queue == nullptr || queue->empty())
+			continue;
+
+		if (type < m_handlers.size())
+			queue->drain(m_handlers[type].handlers);
+		else
+			queue->drain({});
 	}
+}
+
+IEventQueue* EventDispatcher::getQueue(EventTypeId type)
+{
+	return type < m_queues.size() ? m_queues[type].get() : nullptr;
+}
+
+IEventQueue* EventDispatcher::addQueue(EventTypeId type, std::unique_ptr<IEventQueue> queue)
+{
+	if (type >= m_queues.size())
+		m_queues.resize(type + 1);
+
+	m_queues[type] = std::move(queue);
+	return m_queues[type].get();
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "EventRecording.h"
+#include <Yxis/Logger.h>
+
+using namespace Yxis::Events;
+using namespace Yxis::Events::Recording;
+
+#pragma pack(push, 1)
+struct KeyPayload
+{
+   uint32_t key;
+   uint32_t scancode;
+   uint16_t mod;
+   uint8_t  down;
+   uint8_t  repeat;
+};
+
+struct WindowPayload
+{
+   int32_t data1;
+   int32_t data2;
+};
+
+struct MotionPayload
+{
+   float    x, y;
+   float    xrel, yrel;
+   uint32_t state;
+};
+
+struct ButtonPayload
+{
+   float   x, y;
+   uint8_t button;
+   uint8_t down;
+   uint8_t clicks;
+};
+#pragma pack(pop)
+
+template <typename Payload>
+static void writeRecord(std::ofstream& file, uint64_t timestamp, uint32_t type, const Payload* payload)
+{
+   const RecordHeader header = { timestamp, type, payload ? static_cast<uint16_t>(sizeof(Payload)) : uint16_t(0) };
+   file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   if (payload)
+      file.write(reinterpret_cast<const char*>(payload), sizeof(Payload));
+}
+
+template <typename Payload>
+static Payload readPayload(const std::byte* data, uint16_t size)
+{
+   Payload payload{};
+   std::memcpy(&payload, data, std::min<size_t>(size, sizeof(Payload)));
+   return payload;
+}
+
+EventRecorder::EventRecorder(const std::string_view path)
+   : m_file(std::string(path), std::ios::binary | std::ios::trunc)
+{
+   if (not m_file)
+      throw std::runtime_error(fmt::format("Failed to open event recording file {}", path));
+
+   const FileHeader header = { MAGIC, VERSION };
+   m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   YX_CORE_LOGGER->info("Recording events to {}", path);
+}
+
+EventRecorder::~EventRecorder()
+{
+   YX_CORE_LOGGER->info("Recorded {} events", m_recordedCount);
+}
+
+void EventRecorder::record(const SDL_Event& event)
+{
+   const bool isWindowEvent = event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST;
+   switch (event.type)
+   {
+   case SDL_EVENT_QUIT:
+   case SDL_EVENT_KEY_DOWN:
+   case SDL_EVENT_KEY_UP:
+   case SDL_EVENT_MOUSE_MOTION:
+   case SDL_EVENT_MOUSE_BUTTON_DOWN:
+   case SDL_EVENT_MOUSE_BUTTON_UP:
+      break;
+   default:
+      if (not isWindowEvent)
+         return;
+   }
+
+   if (not m_startTimestamp.has_value())
+      m_startTimestamp = event.common.timestamp;
+   const uint64_t timestamp = event.common.timestamp - m_startTimestamp.value();
+
+   if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP)
+   {
+      const KeyPayload payload = { event.key.key, event.key.scancode, event.key.mod, event.key.down, event.key.repeat };
+      writeRecord(m_file, timestamp, event.type, &payload);
+   }
+   else if (event.type == SDL_EVENT_MOUSE_MOTION)
+   {
+      const MotionPayload payload = { event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel, event.motion.state };
+      writeRecord(m_file, timestamp, event.type, &payload);
+   }
+   else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP)
+   {
+      const ButtonPayload payload = { event.button.x, event.button.y, event.button.button, event.button.down, event.button.clicks };
+      writeRecord(m_file, timestamp, event.type, &payload);
+   }
+   else if (isWindowEvent)
+   {
+      const WindowPayload payload = { event.window.data1, event.window.data2 };
+      writeRecord(m_file, timestamp, event.type, &payload);
+   }
+   else
+      writeRecord<WindowPayload>(m_file, timestamp, event.type, nullptr);
+
+   m_recordedCount++;
+}
+
+EventPlayer::EventPlayer(const std::string_view path)
+{
+   // read everything upfront so replay doesn't do file I/O mid-frame
+   std::ifstream file(std::string(path), std::ios::binary | std::ios::ate);
+   if (not file)
+      throw std::runtime_error(fmt::format("Failed to open event recording file {}", path));
+
+   const auto size = static_cast<size_t>(file.tellg());
+   FileHeader header{};
+   if (size < sizeof(header))
+      throw std::runtime_error(fmt::format("{} is not an event recording", path));
+
+   m_data.resize(size);
+   file.seekg(0);
+   file.read(reinterpret_cast<char*>(m_data.data()), size);
+   std::memcpy(&header, m_data.data(), sizeof(header));
+   if (header.magic != MAGIC || header.version != VERSION)
+      throw std::runtime_error(fmt::format("{} is not a supported event recording", path));
+
+   m_offset = sizeof(header);
+   m_startTicks = SDL_GetTicksNS();
+   YX_CORE_LOGGER->info("Replaying events from {}", path);
+}
+
+bool EventPlayer::poll(SDL_Event& event)
+{
+   if (m_offset + sizeof(RecordHeader) > m_data.size())
+      return false;
+
+   RecordHeader header;
+   std::memcpy(&header, m_data.data() + m_offset, sizeof(header));
+   if (m_offset + sizeof(header) + header.payloadSize > m_data.size())
+   {
+      YX_CORE_LOGGER->warn("Event recording is truncated, stopping replay");
+      m_offset = m_data.size();
+      return false;
+   }
+
+   const uint64_t now = SDL_GetTicksNS();
+   if (now - m_startTicks < header.timestamp)
+      return false;
+
+   const std::byte* payload = m_data.data() + m_offset + sizeof(header);
+   m_offset += sizeof(header) + header.payloadSize;
+
+   event = {};
+   event.type = header.type;
+   event.common.timestamp = m_startTicks + header.timestamp;
+
+   if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP)
+   {
+      const auto key = readPayload<KeyPayload>(payload, header.payloadSize);
+      event.key.key = key.key;
+      event.key.scancode = static_cast<SDL_Scancode>(key.scancode);
+      event.key.mod = key.mod;
+      event.key.down = key.down;
+      event.key.repeat = key.repeat;
+   }
+   else if (event.type == SDL_EVENT_MOUSE_MOTION)
+   {
+      const auto motion = readPayload<MotionPayload>(payload, header.payloadSize);
+      event.motion.x = motion.x;
+      event.motion.y = motion.y;
+      event.motion.xrel = motion.xrel;
+      event.motion.yrel = motion.yrel;
+      event.motion.state = motion.state;
+   }
+   else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP)
+   {
+      const auto button = readPayload<ButtonPayload>(payload, header.payloadSize);
+      event.button.x = button.x;
+      event.button.y = button.y;
+      event.button.button = button.button;
+      event.button.down = button.down;
+      event.button.clicks = button.clicks;
+   }
+   else if (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST)
+   {
+      const auto window = readPayload<WindowPayload>(payload, header.payloadSize);
+      event.window.data1 = window.data1;
+      event.window.data2 = window.data2;
+   }
+
+   return true;
+}
+
+bool EventPlayer::finished() const
+{
+   return m_offset >= m_data.size();
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../internal_pch.h"
+
+namespace Yxis::Events
+{
+   // Binary capture of the SDL events Application::run consumes.
+   // Layout: FileHeader, then records of RecordHeader followed by payloadSize bytes.
+   // Timestamps are nanoseconds since the first recorded event.
+   namespace Recording
+   {
+      constexpr uint32_t MAGIC = 0x56455859; // "YXEV"
+      constexpr uint32_t VERSION = 1;
+
+#pragma pack(push, 1)
+      struct FileHeader
+      {
+         uint32_t magic;
+         uint32_t version;
+      };
+
+      struct RecordHeader
+      {
+         uint64_t timestamp;
+         uint32_t type;
+         uint16_t payloadSize;
+      };
+#pragma pack(pop)
+   }
+
+   class EventRecorder
+   {
+   public:
+      EventRecorder(const std::string_view path);
+      ~EventRecorder();
+
+      EventRecorder(const EventRecorder&) = delete;
+      EventRecorder& operator=(const EventRecorder&) = delete;
+
+      // events the engine doesn't consume are skipped
+      void record(const SDL_Event& event);
+   private:
+      std::ofstream m_file;
+      std::optional<uint64_t> m_startTimestamp;
+      uint64_t m_recordedCount = 0;
+   };
+
+   // Replays a recording in place of SDL_PollEvent, releasing each event once its timestamp is reached
+   class EventPlayer
+   {
+   public:
+      EventPlayer(const std::string_view path);
+
+      bool poll(SDL_Event& event);
+      bool finished() const;
+   private:
+      std::vector<std::byte> m_data;
+      size_t m_offset = 0;
+      uint64_t m_startTicks = 0;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include <Yxis/Events/EventTypeId.h>
+#include <mutex>
+
+using namespace Yxis::Events;
+
+static std::mutex s_registryMutex;
+static std::unordered_map<std::string, EventTypeId> s_typeIds;
+
+EventTypeId EventTypeRegistry::registerType(std::string_view signature)
+{
+	std::lock_guard lock(s_registryMutex);
+	auto [it, inserted] = s_typeIds.try_emplace(std::string(signature), static_cast<EventTypeId>(s_typeIds.size()));
+	return it->second;
+}
+
+size_t EventTypeRegistry::getTypeCount()
+{
+	std::lock_guard lock(s_registryMutex);
+	return s_typeIds.size();
+}
\ No newline at end of file
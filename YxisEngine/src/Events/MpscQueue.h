@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../internal_pch.h"
+
+namespace Yxis::Events
+{
+	// Intrusive multi-producer single-consumer queue (Dmitry Vyukov's algorithm).
+	// push() is wait-free and can be called from any thread, pop() only from the consumer.
+	// Node must have an std::atomic<Node*> next member.
+	template <typename Node>
+	class MpscQueue
+	{
+	public:
+		MpscQueue()
+			: m_head(&m_stub), m_tail(&m_stub) { }
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		void push(Node* node)
+		{
+			node->next.store(nullptr, std::memory_order_relaxed);
+			Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+			previous->next.store(node, std::memory_order_release);
+		}
+
+		// returns nullptr if the queue is empty or a producer is halfway through a push
+		Node* pop()
+		{
+			Node* tail = m_tail;
+			Node* next = tail->next.load(std::memory_order_acquire);
+			if (tail == &m_stub)
+			{
+				if (next == nullptr)
+					return nullptr;
+
+				m_tail = next;
+				tail = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+
+			if (next != nullptr)
+			{
+				m_tail = next;
+				return tail;
+			}
+
+			if (tail != m_head.load(std::memory_order_acquire))
+				return nullptr;
+
+			push(&m_stub);
+			next = tail->next.load(std::memory_order_acquire);
+			if (next != nullptr)
+			{
+				m_tail = next;
+				return tail;
+			}
+
+			return nullptr;
+		}
+	private:
+		alignas(64) std::atomic<Node*> m_head;
+		alignas(64) Node* m_tail;
+		Node m_stub;
+	};
+}
\ No newline at end of file
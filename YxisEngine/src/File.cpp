@@ -0,0 +1,17 @@
+#include "File.h"
+
+using namespace Yxis;
+
+std::optional<std::vector<std::byte>> File::readAll(const std::filesystem::path& path)
+{
+   std::ifstream file(path, std::ios::binary | std::ios::ate);
+   if (not file)
+      return std::nullopt;
+
+   std::vector<std::byte> data(static_cast<size_t>(file.tellg()));
+   file.seekg(0);
+   if (not file.read(reinterpret_cast<char*>(data.data()), data.size()))
+      return std::nullopt;
+
+   return data;
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "internal_pch.h"
+#include <filesystem>
+
+namespace Yxis
+{
+   class File
+   {
+   public:
+      // whole file contents, std::nullopt if it can't be opened or read
+      static std::optional<std::vector<std::byte>> readAll(const std::filesystem::path& path);
+   };
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <Yxis/FrameArena.h>
+#include <Yxis/JobSystem.h>
+#include <Yxis/Logger.h>
+
+namespace Yxis
+{
+   // bump allocator over a list of blocks, reset only rewinds so the blocks are reused every frame
+   // cache line aligned, every worker writes its own one
+   struct alignas(64) SubArena
+   {
+      struct Block
+      {
+         std::unique_ptr<std::byte[]> memory;
+         size_t size = 0;
+      };
+
+      std::vector<Block> blocks;
+      size_t blockIndex = 0;
+      size_t offset = 0;
+      // only written by the owner, read by getBytesAllocated
+      std::atomic<size_t> bytesAllocated = 0;
+
+      void* allocate(const size_t size, const size_t alignment)
+      {
+         while (true)
+         {
+            if (blockIndex < blocks.size())
+            {
+               Block& block = blocks[blockIndex];
+               const uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+               const size_t alignedOffset = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+               if (alignedOffset + size <= block.size)
+               {
+                  offset = alignedOffset + size;
+                  bytesAllocated.store(bytesAllocated.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+                  return block.memory.get() + alignedOffset;
+               }
+               blockIndex++;
+               offset = 0;
+               continue;
+            }
+
+            // padded so an oversized request always fits whatever the alignment
+            const size_t blockSize = std::max(FrameArena::BLOCK_SIZE, size + alignment);
+            blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(blockSize), blockSize });
+         }
+      }
+
+      void reset()
+      {
+         blockIndex = 0;
+         offset = 0;
+         bytesAllocated.store(0, std::memory_order_relaxed);
+      }
+   };
+
+   // deallocation is a no-op, everything goes away with the frame
+   class FrameArenaResource : public std::pmr::memory_resource
+   {
+   private:
+      void* do_allocate(const size_t bytes, const size_t alignment) override { return FrameArena::allocate(bytes, alignment); }
+      void do_deallocate(void*, size_t, size_t) override {}
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+   };
+
+   // one sub-arena per worker plus a shared one for other threads, per buffered frame
+   static std::array<std::unique_ptr<SubArena[]>, FrameArena::FRAME_COUNT> s_frames;
+   static uint32_t s_subArenaCount = 0;
+   static std::mutex s_sharedMutex;
+   static std::atomic<uint32_t> s_currentFrame = 0;
+   static FrameArenaResource s_memoryResource;
+
+   void FrameArena::initialize()
+   {
+      if (s_subArenaCount != 0) return;
+
+      s_subArenaCount = JobSystem::getWorkerCount() + 1;
+      for (auto& frame : s_frames)
+         frame = std::make_unique<SubArena[]>(s_subArenaCount);
+      s_currentFrame.store(0, std::memory_order_relaxed);
+      YX_CORE_LOGGER->info("Frame arena initialized with {} sub-arenas per frame", s_subArenaCount);
+   }
+
+   void FrameArena::shutdown()
+   {
+      for (auto& frame : s_frames)
+         frame.reset();
+      s_subArenaCount = 0;
+   }
+
+   void FrameArena::beginFrame()
+   {
+      // frame n - FRAME_COUNT is done on the render thread by now, see RenderThread::MAX_FRAMES_AHEAD
+      const uint32_t frame = (s_currentFrame.load(std::memory_order_relaxed) + 1) % FRAME_COUNT;
+      std::lock_guard lock(s_sharedMutex);
+      for (uint32_t i = 0; i < s_subArenaCount; i++)
+         s_frames[frame][i].reset();
+      s_currentFrame.store(frame, std::memory_order_release);
+   }
+
+   void* FrameArena::allocate(const size_t size, const size_t alignment)
+   {
+      if (s_subArenaCount == 0)
+         throw std::runtime_error("Frame arena used before initialization");
+      if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+         throw std::runtime_error(fmt::format("Frame arena alignment {} is not a power of two", alignment));
+
+      SubArena* subArenas = s_frames[s_currentFrame.load(std::memory_order_acquire)].get();
+      const uint32_t workerIndex = JobSystem::getWorkerIndex();
+      if (workerIndex < s_subArenaCount - 1)
+         return subArenas[workerIndex].allocate(size, alignment);
+
+      std::lock_guard lock(s_sharedMutex);
+      return subArenas[s_subArenaCount - 1].allocate(size, alignment);
+   }
+
+   std::pmr::memory_resource* FrameArena::getMemoryResource()
+   {
+      return &s_memoryResource;
+   }
+
+   size_t FrameArena::getBytesAllocated()
+   {
+      if (s_subArenaCount == 0) return 0;
+
+      const SubArena* subArenas = s_frames[s_currentFrame.load(std::memory_order_acquire)].get();
+      size_t bytes = 0;
+      for (uint32_t i = 0; i < s_subArenaCount; i++)
+         bytes += subArenas[i].bytesAllocated.load(std::memory_order_relaxed);
+      return bytes;
+   }
+}
\ No newline at end of file
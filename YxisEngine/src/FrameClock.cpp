@@ -0,0 +1,100 @@
+#include "FrameClock.h"
+
+namespace Yxis
+{
+   // sleeping is only accurate to about a millisecond, the rest is spent spinning
+   static constexpr double SPIN_THRESHOLD = 0.002;
+
+   FrameClock::FrameClock()
+      : m_frequency(SDL_GetPerformanceFrequency())
+   {
+   }
+
+   uint64_t FrameClock::now()
+   {
+      return SDL_GetPerformanceCounter();
+   }
+
+   uint64_t FrameClock::getFrequency()
+   {
+      return SDL_GetPerformanceFrequency();
+   }
+
+   double FrameClock::beginFrame()
+   {
+      const uint64_t frameStart = now();
+      if (m_frameStart == 0)
+      {
+         m_frameStart = frameStart;
+         return 0.0;
+      }
+
+      const double delta = static_cast<double>(frameStart - m_frameStart) / m_frequency;
+      m_frameStart = frameStart;
+
+      m_frameTimes[m_nextFrameTime] = static_cast<float>(delta * 1000.0);
+      m_nextFrameTime = (m_nextFrameTime + 1) % m_frameTimes.size();
+      m_frameTimeCount = std::min(m_frameTimeCount + 1, m_frameTimes.size());
+
+      m_accumulator += std::min(delta, MAX_FRAME_DELTA);
+      return delta;
+   }
+
+   void FrameClock::reset()
+   {
+      m_frameStart = 0;
+      m_accumulator = 0.0;
+   }
+
+   bool FrameClock::consumeFixedStep(const double step)
+   {
+      if (m_accumulator < step)
+         return false;
+
+      m_accumulator -= step;
+      return true;
+   }
+
+   double FrameClock::getInterpolationAlpha(const double step) const
+   {
+      return std::clamp(m_accumulator / step, 0.0, 1.0);
+   }
+
+   void FrameClock::waitForFrameEnd(const double frameTime) const
+   {
+      const uint64_t frameEnd = m_frameStart + static_cast<uint64_t>(frameTime * m_frequency);
+      const uint64_t current = now();
+      if (current >= frameEnd)
+         return;
+
+      const double remaining = static_cast<double>(frameEnd - current) / m_frequency;
+      if (remaining > SPIN_THRESHOLD)
+         SDL_DelayNS(static_cast<uint64_t>((remaining - SPIN_THRESHOLD) * 1e9));
+
+      while (now() < frameEnd)
+         std::this_thread::yield();
+   }
+
+   FrameStatistics FrameClock::getStatistics() const
+   {
+      FrameStatistics statistics;
+      statistics.frameCount = static_cast<uint32_t>(m_frameTimeCount);
+      if (m_frameTimeCount == 0)
+         return statistics;
+
+      std::array<float, FrameStatistics::WINDOW_SIZE> sorted;
+      std::copy_n(m_frameTimes.begin(), m_frameTimeCount, sorted.begin());
+      const auto end = sorted.begin() + m_frameTimeCount;
+      std::sort(sorted.begin(), end);
+
+      double sum = 0.0;
+      for (auto it = sorted.begin(); it != end; it++)
+         sum += *it;
+
+      statistics.minMs = sorted[0];
+      statistics.maxMs = sorted[m_frameTimeCount - 1];
+      statistics.averageMs = sum / m_frameTimeCount;
+      statistics.p99Ms = sorted[(m_frameTimeCount - 1) * 99 / 100];
+      return statistics;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "internal_pch.h"
+#include <Yxis/FrameStatistics.h>
+
+namespace Yxis
+{
+   // Frame timing on top of SDL's performance counter: frame deltas, a fixed timestep
+   // accumulator, frame rate limiting and rolling frame time statistics.
+   class FrameClock
+   {
+   public:
+      FrameClock();
+
+      static uint64_t now();
+      static uint64_t getFrequency();
+
+      // starts a new frame, returns seconds since the previous one
+      double beginFrame();
+      // forgets the previous frame, e.g. after the loop was paused
+      void reset();
+
+      // call in a loop, returns true while a whole fixed step is left in the accumulator
+      bool consumeFixedStep(const double step);
+      // how far the accumulator is into the next fixed step, 0..1
+      double getInterpolationAlpha(const double step) const;
+
+      // sleeps, then spins until the frame started by beginFrame() lasted at least frameTime seconds
+      void waitForFrameEnd(const double frameTime) const;
+
+      FrameStatistics getStatistics() const;
+   private:
+      // deltas above this (breakpoints, window drags) are clamped so fixed updates don't spiral
+      static constexpr double MAX_FRAME_DELTA = 0.25;
+
+      const uint64_t m_frequency;
+      uint64_t m_frameStart = 0;
+      double m_accumulator = 0.0;
+
+      std::array<float, FrameStatistics::WINDOW_SIZE> m_frameTimes{};
+      size_t m_frameTimeCount = 0;
+      size_t m_nextFrameTime = 0;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <Yxis/Input.h>
+
+namespace Yxis
+{
+   // KeyCodes.h spells out SDL's values so clients don't need SDL headers
+   static_assert(KEY_SCANCODE_MASK == SDLK_SCANCODE_MASK);
+   static_assert(KEY_RETURN == SDLK_RETURN && KEY_ESCAPE == SDLK_ESCAPE && KEY_BACKSPACE == SDLK_BACKSPACE);
+   static_assert(KEY_TAB == SDLK_TAB && KEY_SPACE == SDLK_SPACE && KEY_DELETE == SDLK_DELETE);
+   static_assert(KEY_0 == SDLK_0 && KEY_9 == SDLK_9 && KEY_A == SDLK_A && KEY_Z == SDLK_Z);
+   static_assert(KEY_F1 == SDLK_F1 && KEY_F9 == SDLK_F9 && KEY_F10 == SDLK_F10 && KEY_F12 == SDLK_F12);
+   static_assert(KEY_INSERT == SDLK_INSERT && KEY_HOME == SDLK_HOME && KEY_PAGE_UP == SDLK_PAGEUP);
+   static_assert(KEY_END == SDLK_END && KEY_PAGE_DOWN == SDLK_PAGEDOWN);
+   static_assert(KEY_RIGHT == SDLK_RIGHT && KEY_LEFT == SDLK_LEFT && KEY_DOWN == SDLK_DOWN && KEY_UP == SDLK_UP);
+   static_assert(KEY_LEFT_CTRL == SDLK_LCTRL && KEY_LEFT_SHIFT == SDLK_LSHIFT && KEY_LEFT_ALT == SDLK_LALT && KEY_LEFT_GUI == SDLK_LGUI);
+   static_assert(KEY_RIGHT_CTRL == SDLK_RCTRL && KEY_RIGHT_SHIFT == SDLK_RSHIFT && KEY_RIGHT_ALT == SDLK_RALT && KEY_RIGHT_GUI == SDLK_RGUI);
+   static_assert(KEYMOD_SHIFT == SDL_KMOD_SHIFT && KEYMOD_CTRL == SDL_KMOD_CTRL && KEYMOD_ALT == SDL_KMOD_ALT && KEYMOD_GUI == SDL_KMOD_GUI);
+   static_assert(KEYMOD_LEFT_SHIFT == SDL_KMOD_LSHIFT && KEYMOD_RIGHT_CTRL == SDL_KMOD_RCTRL && KEYMOD_LEFT_ALT == SDL_KMOD_LALT);
+
+   std::array<uint32_t, Input::MAX_HELD_KEYS> Input::m_heldKeys;
+   uint32_t Input::m_heldKeyCount = 0;
+   uint32_t Input::m_modifiers = 0;
+   uint32_t Input::m_mouseButtons = 0;
+   float Input::m_mouseX = 0.0f;
+   float Input::m_mouseY = 0.0f;
+   float Input::m_mouseDeltaX = 0.0f;
+   float Input::m_mouseDeltaY = 0.0f;
+
+   void Input::beginFrame()
+   {
+      m_mouseDeltaX = 0.0f;
+      m_mouseDeltaY = 0.0f;
+   }
+
+   void Input::reset()
+   {
+      // focus was lost, key up events won't arrive
+      m_heldKeyCount = 0;
+      m_modifiers = 0;
+      m_mouseButtons = 0;
+   }
+
+   void Input::setKey(const uint32_t key, const bool down, const uint32_t modifiers)
+   {
+      const auto end = m_heldKeys.begin() + m_heldKeyCount;
+      const auto held = std::find(m_heldKeys.begin(), end, key);
+      if (down && held == end && m_heldKeyCount < MAX_HELD_KEYS)
+         m_heldKeys[m_heldKeyCount++] = key;
+      else if (not down && held != end)
+         *held = m_heldKeys[--m_heldKeyCount];
+
+      m_modifiers = modifiers;
+   }
+
+   void Input::setMouseMotion(const float x, const float y, const float deltaX, const float deltaY)
+   {
+      m_mouseX = x;
+      m_mouseY = y;
+      m_mouseDeltaX += deltaX;
+      m_mouseDeltaY += deltaY;
+   }
+
+   void Input::setMouseButton(const uint32_t button, const bool down)
+   {
+      if (button == 0 || button > 32)
+         return;
+
+      const uint32_t mask = 1u << (button - 1);
+      if (down)
+         m_mouseButtons |= mask;
+      else
+         m_mouseButtons &= ~mask;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include <Yxis/JobSystem.h>
+#include <Yxis/Logger.h>
+#include <Yxis/CommandLine.h>
+#include <Yxis/Profiler.h>
+#include "Jobs/WorkStealingDeque.h"
+#include <charconv>
+#include <deque>
+
+#ifdef YX_WINDOWS
+   #define WIN32_LEAN_AND_MEAN
+   #define NOMINMAX
+   #include <Windows.h>
+#elif defined(__linux__)
+   #include <pthread.h>
+   #include <sched.h>
+#endif
+
+namespace Yxis
+{
+   // twice the deque capacity, so looking for a free slot always ends quickly
+   static constexpr uint32_t JOB_POOL_SIZE = JobSystem::MAX_JOBS_IN_FLIGHT * 2;
+   // rounds without finding work before an idle worker goes to sleep
+   static constexpr uint32_t SPIN_COUNT = 64;
+
+   struct Worker
+   {
+      Jobs::WorkStealingDeque<Job, JobSystem::MAX_JOBS_IN_FLIGHT> deque;
+      std::array<Job, JOB_POOL_SIZE> jobs;
+      // set while a slot is queued, cleared by whoever took the job once it's copied out
+      std::array<std::atomic<bool>, JOB_POOL_SIZE> slotInUse{};
+      uint32_t nextJob = 0;
+      uint32_t nextVictim = 0;
+      std::thread thread;
+   };
+
+   static std::vector<std::unique_ptr<Worker>> s_workers;
+   static bool s_initialized = false;
+   static std::atomic<bool> s_running = false;
+
+   // jobs submitted by threads that aren't workers (render thread, loaders, ...)
+   static std::mutex s_injectedMutex;
+   static std::deque<Job> s_injectedJobs;
+   static std::atomic<uint32_t> s_injectedCount = 0;
+
+   // bumped on every submission and whenever a counter drops to zero. idle workers and threads in wait()
+   // sleep on it, not on the counter: a waiter may destroy its counter the moment it reads zero
+   static std::atomic<uint32_t> s_jobSignal = 0;
+   static std::atomic<uint32_t> s_sleepingThreads = 0;
+
+   static thread_local uint32_t t_workerIndex = UINT32_MAX;
+
+   static Job takeJob(Worker& owner, const Job* slot)
+   {
+      const Job job = *slot;
+      owner.slotInUse[slot - owner.jobs.data()].store(false, std::memory_order_release);
+      return job;
+   }
+
+   static void pinToCore(const uint32_t core)
+   {
+#ifdef YX_WINDOWS
+      SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(core, &set);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+         YX_CORE_LOGGER->warn("Failed to pin job worker to core {}", core);
+#else
+      (void)core;
+#endif
+   }
+
+   void JobSystem::initialize()
+   {
+      if (s_initialized) return;
+
+      uint32_t workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+      if (const auto option = CommandLine::getOption("job-workers"))
+         std::from_chars(option->data(), option->data() + option->size(), workerCount);
+      workerCount = std::max(workerCount, 1u);
+      const bool pinWorkers = CommandLine::hasOption("pin-workers");
+
+      s_workers.reserve(workerCount);
+      for (uint32_t i = 0; i < workerCount; i++)
+         s_workers.push_back(std::make_unique<Worker>());
+
+      // the calling thread is worker 0, it runs jobs whenever it waits on a counter
+      t_workerIndex = 0;
+      if (pinWorkers)
+         pinToCore(0);
+
+      s_running.store(true, std::memory_order_relaxed);
+      s_initialized = true;
+      for (uint32_t i = 1; i < workerCount; i++)
+      {
+         s_workers[i]->thread = std::thread([i, pinWorkers]() {
+            if (pinWorkers)
+               pinToCore(i);
+            workerMain(i);
+         });
+      }
+
+      YX_CORE_LOGGER->info("Job system started with {} workers{}", workerCount, pinWorkers ? " (pinned)" : "");
+   }
+
+   void JobSystem::shutdown()
+   {
+      if (not s_initialized) return;
+
+      s_running.store(false, std::memory_order_relaxed);
+      s_jobSignal.fetch_add(1);
+      s_jobSignal.notify_all();
+      for (auto& worker : s_workers)
+      {
+         if (worker->thread.joinable())
+            worker->thread.join();
+      }
+
+      // whatever is left over still runs, counters may be waited on after shutdown
+      while (tryRunJob());
+
+      s_workers.clear();
+      t_workerIndex = UINT32_MAX;
+      s_initialized = false;
+   }
+
+   uint32_t JobSystem::getWorkerCount()
+   {
+      return std::max(static_cast<uint32_t>(s_workers.size()), 1u);
+   }
+
+   uint32_t JobSystem::getWorkerIndex()
+   {
+      return t_workerIndex;
+   }
+
+   void JobSystem::submit(const Job& job)
+   {
+      if (job.counter)
+         retain(*job.counter);
+
+      // not started (or already stopped), behave like a single threaded engine
+      if (not s_initialized)
+      {
+         execute(job);
+         return;
+      }
+
+      if (t_workerIndex != UINT32_MAX)
+      {
+         Worker& worker = *s_workers[t_workerIndex];
+         uint32_t slotIndex;
+         do
+            slotIndex = worker.nextJob++ & (JOB_POOL_SIZE - 1);
+         while (worker.slotInUse[slotIndex].load(std::memory_order_acquire));
+
+         worker.jobs[slotIndex] = job;
+         worker.slotInUse[slotIndex].store(true, std::memory_order_relaxed);
+
+         // more than MAX_JOBS_IN_FLIGHT queued on this worker, run it right away instead
+         if (not worker.deque.push(&worker.jobs[slotIndex]))
+         {
+            worker.slotInUse[slotIndex].store(false, std::memory_order_relaxed);
+            execute(job);
+            return;
+         }
+      }
+      else
+      {
+         std::lock_guard lock(s_injectedMutex);
+         s_injectedJobs.push_back(job);
+         s_injectedCount.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      s_jobSignal.fetch_add(1);
+      // whoever wakes up runs it, idle workers and waiters alike
+      if (s_sleepingThreads.load() != 0)
+         s_jobSignal.notify_one();
+   }
+
+   void JobSystem::execute(const Job& job)
+   {
+      job.function(job.storage);
+      if (job.counter)
+         release(*job.counter);
+   }
+
+   void JobSystem::retain(JobCounter& counter)
+   {
+      counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   void JobSystem::release(JobCounter& counter)
+   {
+      // the decrement is the last access to the counter
+      if (counter.m_pending.fetch_sub(1) == 1)
+      {
+         s_jobSignal.fetch_add(1);
+         if (s_sleepingThreads.load() != 0)
+            s_jobSignal.notify_all();
+      }
+   }
+
+   bool JobSystem::tryRunJob()
+   {
+      const uint32_t index = t_workerIndex;
+      Job job;
+
+      if (index != UINT32_MAX)
+      {
+         if (Job* own = s_workers[index]->deque.pop())
+         {
+            job = takeJob(*s_workers[index], own);
+            execute(job);
+            return true;
+         }
+      }
+
+      if (s_injectedCount.load(std::memory_order_relaxed) != 0)
+      {
+         bool found = false;
+         {
+            std::lock_guard lock(s_injectedMutex);
+            if (not s_injectedJobs.empty())
+            {
+               job = s_injectedJobs.front();
+               s_injectedJobs.pop_front();
+               s_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+               found = true;
+            }
+         }
+
+         if (found)
+         {
+            execute(job);
+            return true;
+         }
+      }
+
+      // each worker walks the victims from its own cursor so thieves don't all hit the same deque
+      const uint32_t workerCount = static_cast<uint32_t>(s_workers.size());
+      uint32_t victim = index != UINT32_MAX ? s_workers[index]->nextVictim++ : 0;
+      for (uint32_t i = 0; i < workerCount; i++, victim++)
+      {
+         const uint32_t victimIndex = victim % workerCount;
+         if (victimIndex == index)
+            continue;
+
+         if (Job* stolen = s_workers[victimIndex]->deque.steal())
+         {
+            job = takeJob(*s_workers[victimIndex], stolen);
+            execute(job);
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   void JobSystem::wait(const JobCounter& counter)
+   {
+      uint32_t spins = 0;
+      for (;;)
+      {
+         if (counter.m_pending.load(std::memory_order_acquire) == 0)
+            return;
+
+         if (tryRunJob())
+         {
+            spins = 0;
+            continue;
+         }
+
+         if (++spins < SPIN_COUNT)
+         {
+            std::this_thread::yield();
+            continue;
+         }
+
+         // nothing left to help with, the remaining jobs are running elsewhere. sleep like an idle worker,
+         // a submission wakes it as well as the counter reaching zero
+         const uint32_t signal = s_jobSignal.load();
+         if (tryRunJob())
+         {
+            spins = 0;
+            continue;
+         }
+         if (counter.m_pending.load() == 0)
+            return;
+
+         s_sleepingThreads.fetch_add(1);
+         s_jobSignal.wait(signal);
+         s_sleepingThreads.fetch_sub(1);
+         spins = 0;
+      }
+   }
+
+   void JobSystem::workerMain(const uint32_t index)
+   {
+      t_workerIndex = index;
+      s_workers[index]->nextVictim = index + 1;
+      Profiler::setThreadName(fmt::format("Job worker {}", index));
+
+      uint32_t spins = 0;
+      while (s_running.load(std::memory_order_relaxed))
+      {
+         if (tryRunJob())
+         {
+            spins = 0;
+            continue;
+         }
+
+         if (++spins < SPIN_COUNT)
+         {
+            std::this_thread::yield();
+            continue;
+         }
+
+         // read the signal before the last look, a job submitted after it changes the value and wait returns right away
+         const uint32_t signal = s_jobSignal.load();
+         if (tryRunJob())
+         {
+            spins = 0;
+            continue;
+         }
+
+         s_sleepingThreads.fetch_add(1);
+         s_jobSignal.wait(signal);
+         s_sleepingThreads.fetch_sub(1);
+         spins = 0;
+      }
+   }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <bit>
+
+namespace Yxis::Jobs
+{
+   // Fixed capacity Chase-Lev deque ("Correct and Efficient Work-Stealing for Weak Memory Models", Le et al.).
+   // The owning thread pushes and pops at the bottom, any thread may steal from the top.
+   template <typename T, size_t Capacity>
+   class WorkStealingDeque
+   {
+      static_assert(std::has_single_bit(Capacity), "Capacity has to be a power of two");
+   public:
+      WorkStealingDeque() = default;
+      WorkStealingDeque(const WorkStealingDeque&) = delete;
+      WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+      // owner only, returns false if the deque is full
+      bool push(T* item)
+      {
+         const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+         const int64_t top = m_top.load(std::memory_order_acquire);
+         if (bottom - top >= static_cast<int64_t>(Capacity))
+            return false;
+
+         m_items[bottom & (Capacity - 1)].store(item, std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_release);
+         m_bottom.store(bottom + 1, std::memory_order_relaxed);
+         return true;
+      }
+
+      // owner only, newest item first
+      T* pop()
+      {
+         const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+         m_bottom.store(bottom, std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         int64_t top = m_top.load(std::memory_order_relaxed);
+
+         if (top > bottom)
+         {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+         }
+
+         T* item = m_items[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+         if (top == bottom)
+         {
+            // last item, race the thieves for it
+            if (not m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+               item = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+         }
+         return item;
+      }
+
+      // any thread, oldest item first. nullptr if empty or another thread won the race
+      T* steal()
+      {
+         int64_t top = m_top.load(std::memory_order_acquire);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+         if (top >= bottom)
+            return nullptr;
+
+         T* item = m_items[top & (Capacity - 1)].load(std::memory_order_relaxed);
+         if (not m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+         return item;
+      }
+
+      bool empty() const
+      {
+         return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+      }
+   private:
+      alignas(64) std::atomic<int64_t> m_top = 0;
+      alignas(64) std::atomic<int64_t> m_bottom = 0;
+      alignas(64) std::array<std::atomic<T*>, Capacity> m_items{};
+   };
+}
\ No newline at end of file
@@ -1,4 +1,9 @@
 #include <Yxis/Logger.h>
+#include <Yxis/CommandLine.h>
+#include <Yxis/BinaryLog.h>
+#include "Logging/AsyncSink.h"
+#include "Logging/MappedFileSink.h"
+#include <charconv>
 
 namespace Yxis
 {
@@ -6,6 +11,31 @@ namespace Yxis
    Logger::logger_t Logger::m_coreLogger;
    Logger::logger_t Logger::m_clientLogger;
 
+   static constexpr size_t DEFAULT_ASYNC_QUEUE_SIZE = 8192;
+   static constexpr size_t LOG_SEGMENT_SIZE = 4 * 1024 * 1024;
+   static constexpr uint32_t LOG_SEGMENT_COUNT = 4;
+   static std::shared_ptr<Logging::AsyncSink> s_asyncSink;
+
+   static Logging::OverflowPolicy getOverflowPolicy()
+   {
+      const auto option = CommandLine::getOption("log-overflow");
+      if (option == "drop")
+         return Logging::OverflowPolicy::Drop;
+      if (option == "overwrite")
+         return Logging::OverflowPolicy::OverwriteOldest;
+
+      return Logging::OverflowPolicy::Block;
+   }
+
+   static size_t getAsyncQueueSize()
+   {
+      size_t size = DEFAULT_ASYNC_QUEUE_SIZE;
+      if (const auto option = CommandLine::getOption("log-queue-size"))
+         std::from_chars(option->data(), option->data() + option->size(), size);
+
+      return size;
+   }
+
    void Logger::initialize() noexcept
    {
       if (m_initialized) return;
@@ -14,21 +44,49 @@ namespace Yxis
       consoleSink->set_level(spdlog::level::debug);
       consoleSink->set_pattern("%^[%n-%l %T] [TID:%t] %v%$");
 
-      auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("log.txt", true);
+      // log.0.txt .. log.3.txt, 4 MiB each
+      auto fileSink = std::make_shared<Logging::MappedFileSink>("log", ".txt", LOG_SEGMENT_SIZE, LOG_SEGMENT_COUNT);
       fileSink->set_level(spdlog::level::info);
       fileSink->set_pattern("[%n-%l %T] [TID:%t] %v%");
 
-      m_coreLogger.reset(new spdlog::logger("YxisCore", { consoleSink, fileSink }));
-      m_clientLogger.reset(new spdlog::logger("YxisClient", { consoleSink, fileSink }));
+      std::vector<spdlog::sink_ptr> sinks = { consoleSink, fileSink };
+
+      // --async-log moves console and file I/O onto a flush thread
+      // (--log-overflow=block|drop|overwrite, --log-queue-size=<messages>)
+      if (CommandLine::hasOption("async-log"))
+      {
+         s_asyncSink = std::make_shared<Logging::AsyncSink>(sinks, getAsyncQueueSize(), getOverflowPolicy());
+         sinks = { s_asyncSink };
+      }
+
+      m_coreLogger.reset(new spdlog::logger("YxisCore", sinks.begin(), sinks.end()));
+      m_clientLogger.reset(new spdlog::logger("YxisClient", sinks.begin(), sinks.end()));
+      m_initialized = true;
+
+      BinaryLog::initialize();
    }
 
-   Logger::logger_t Logger::getCoreLogger() noexcept
+   void Logger::shutdown() noexcept
    {
-      return m_coreLogger;
+      if (not m_initialized) return;
+
+      BinaryLog::shutdown();
+
+      if (s_asyncSink)
+      {
+         const uint64_t dropped = s_asyncSink->getDroppedCount();
+         if (dropped > 0)
+            m_coreLogger->warn("Async logger dropped {} messages", dropped);
+
+         s_asyncSink->stop();
+      }
+
+      m_coreLogger->flush();
+      m_clientLogger->flush();
    }
 
-   Logger::logger_t Logger::getClientLogger() noexcept
+   uint64_t Logger::getDroppedMessageCount() noexcept
    {
-      return m_clientLogger;
+      return s_asyncSink ? s_asyncSink->getDroppedCount() : 0;
    }
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "AsyncSink.h"
+
+using namespace Yxis::Logging;
+
+AsyncSink::AsyncSink(std::vector<spdlog::sink_ptr> sinks, size_t capacity, OverflowPolicy overflowPolicy)
+   : m_sinks(std::move(sinks)), m_queue(capacity), m_overflowPolicy(overflowPolicy)
+{
+   m_worker = std::thread(&AsyncSink::worker, this);
+}
+
+AsyncSink::~AsyncSink()
+{
+   stop();
+}
+
+void AsyncSink::log(const spdlog::details::log_msg& message)
+{
+   // registered before the check, so stop() either sees this producer or this producer sees the stop
+   m_activeProducers.fetch_add(1);
+   if (m_stopping.load())
+   {
+      m_activeProducers.fetch_sub(1, std::memory_order_release);
+      writeToSinks(message);
+      return;
+   }
+
+   auto write = [&message](spdlog::details::log_msg_buffer& slot) { slot = spdlog::details::log_msg_buffer(message); };
+   while (not m_queue.tryPush(write))
+   {
+      switch (m_overflowPolicy)
+      {
+      case OverflowPolicy::Block:
+         // the flush thread stops making room once it's stopping
+         if (m_stopping.load(std::memory_order_acquire))
+         {
+            m_activeProducers.fetch_sub(1, std::memory_order_release);
+            writeToSinks(message);
+            return;
+         }
+         wakeWorker();
+         std::this_thread::yield();
+         break;
+      case OverflowPolicy::Drop:
+         m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+         m_activeProducers.fetch_sub(1, std::memory_order_release);
+         return;
+      case OverflowPolicy::OverwriteOldest:
+         if (m_queue.tryPop([](spdlog::details::log_msg_buffer&) {}))
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+         break;
+      }
+   }
+
+   wakeWorker();
+   m_activeProducers.fetch_sub(1, std::memory_order_release);
+}
+
+void AsyncSink::flush()
+{
+   m_flushRequested.store(true, std::memory_order_release);
+   wakeWorker();
+}
+
+void AsyncSink::set_pattern(const std::string& pattern)
+{
+   for (const auto& sink : m_sinks)
+      sink->set_pattern(pattern);
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+   for (const auto& sink : m_sinks)
+      sink->set_formatter(formatter->clone());
+}
+
+void AsyncSink::stop()
+{
+   if (m_stopping.exchange(true))
+      return;
+
+   wakeWorker();
+   if (m_worker.joinable())
+      m_worker.join();
+}
+
+uint64_t AsyncSink::getDroppedCount() const
+{
+   return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+void AsyncSink::worker()
+{
+   auto read = [this](spdlog::details::log_msg_buffer& slot) { writeToSinks(slot); };
+   for (;;)
+   {
+      while (m_queue.tryPop(read)) {}
+
+      if (m_flushRequested.exchange(false, std::memory_order_acq_rel))
+      {
+         for (const auto& sink : m_sinks)
+            sink->flush();
+      }
+
+      if (m_stopping.load(std::memory_order_acquire))
+      {
+         // producers that raced with stop() may still be pushing, wait for them before the final drain
+         while (m_activeProducers.load() != 0)
+         {
+            while (m_queue.tryPop(read)) {}
+            std::this_thread::yield();
+         }
+         while (m_queue.tryPop(read)) {}
+         for (const auto& sink : m_sinks)
+            sink->flush();
+         return;
+      }
+
+      // announce the sleep before the final emptiness check, producers check the flag after pushing
+      const uint32_t wakeups = m_wakeups.load(std::memory_order_acquire);
+      m_workerSleeping.store(true, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (m_queue.tryPop(read) || m_flushRequested.load() || m_stopping.load())
+      {
+         m_workerSleeping.store(false, std::memory_order_relaxed);
+         continue;
+      }
+
+      m_wakeups.wait(wakeups, std::memory_order_acquire);
+      m_workerSleeping.store(false, std::memory_order_relaxed);
+   }
+}
+
+void AsyncSink::writeToSinks(const spdlog::details::log_msg& message)
+{
+   for (const auto& sink : m_sinks)
+   {
+      if (sink->should_log(message.level))
+         sink->log(message);
+   }
+}
+
+void AsyncSink::wakeWorker()
+{
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (m_workerSleeping.load(std::memory_order_relaxed))
+   {
+      m_wakeups.fetch_add(1, std::memory_order_release);
+      m_wakeups.notify_one();
+   }
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include "RingBuffer.h"
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/sinks/sink.h>
+
+namespace Yxis::Logging
+{
+   enum class OverflowPolicy
+   {
+      Block,           // spin until the flush thread makes room
+      Drop,            // discard the new message
+      OverwriteOldest, // discard the oldest queued message
+   };
+
+   // Copies messages into a lock-free ring buffer and hands them to the wrapped sinks
+   // on a dedicated flush thread, so logging threads never wait on a sink mutex or I/O.
+   class AsyncSink final : public spdlog::sinks::sink
+   {
+   public:
+      AsyncSink(std::vector<spdlog::sink_ptr> sinks, size_t capacity, OverflowPolicy overflowPolicy);
+      ~AsyncSink() override;
+
+      void log(const spdlog::details::log_msg& message) override;
+      void flush() override;
+      void set_pattern(const std::string& pattern) override;
+      void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+      // drains the queue and joins the flush thread, later messages are written synchronously
+      void stop();
+      uint64_t getDroppedCount() const;
+   private:
+      void worker();
+      void writeToSinks(const spdlog::details::log_msg& message);
+      void wakeWorker();
+
+      std::vector<spdlog::sink_ptr> m_sinks;
+      RingBuffer<spdlog::details::log_msg_buffer> m_queue;
+      const OverflowPolicy m_overflowPolicy;
+
+      std::atomic<uint64_t> m_droppedCount = 0;
+      std::atomic<uint32_t> m_wakeups = 0;
+      std::atomic<bool> m_workerSleeping = false;
+      std::atomic<bool> m_flushRequested = false;
+      std::atomic<bool> m_stopping = false;
+      // producers between their m_stopping check and the end of their push, the final drain waits for them
+      std::atomic<uint32_t> m_activeProducers = 0;
+      std::thread m_worker;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include <Yxis/BinaryLog.h>
+#include <Yxis/Logger.h>
+#include "../internal_pch.h"
+#ifdef SPDLOG_FMT_EXTERNAL
+#include <fmt/args.h>
+#else
+#include <spdlog/fmt/bundled/args.h>
+#endif
+
+using namespace Yxis;
+
+namespace
+{
+   struct RecordHeader
+   {
+      uint32_t formatId;
+      uint32_t payloadSize;
+      int64_t  timestamp; // spdlog::log_clock ticks
+   };
+
+   constexpr uint32_t PADDING_RECORD = UINT32_MAX;
+   constexpr size_t RECORD_ALIGNMENT = sizeof(RecordHeader);
+   constexpr size_t THREAD_BUFFER_SIZE = 64 * 1024; // power of two
+
+   constexpr size_t alignRecord(size_t size)
+   {
+      return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+   }
+
+   struct Format
+   {
+      spdlog::level::level_enum level;
+      const char* format;
+      std::vector<BinaryLogArg> argTypes;
+   };
+
+   // Single-producer single-consumer byte ring owned by one logging thread. Records never wrap,
+   // a padding record skips the tail end of the buffer instead.
+   class ThreadBuffer
+   {
+   public:
+      ThreadBuffer()
+         : m_data(std::make_unique<std::byte[]>(THREAD_BUFFER_SIZE)), m_threadId(spdlog::details::os::thread_id()) { }
+
+      std::byte* reserve(uint32_t formatId, uint32_t payloadSize, int64_t timestamp)
+      {
+         const size_t recordSize = alignRecord(sizeof(RecordHeader) + payloadSize);
+         const size_t head = m_head.load(std::memory_order_relaxed);
+         const size_t tail = m_tail.load(std::memory_order_acquire);
+         const size_t untilEnd = THREAD_BUFFER_SIZE - (head & (THREAD_BUFFER_SIZE - 1));
+         const size_t padding = untilEnd < recordSize ? untilEnd : 0;
+         if (THREAD_BUFFER_SIZE - (head - tail) < padding + recordSize)
+            return nullptr;
+
+         if (padding > 0)
+         {
+            const RecordHeader paddingHeader = { PADDING_RECORD, 0, 0 };
+            std::memcpy(m_data.get() + (head & (THREAD_BUFFER_SIZE - 1)), &paddingHeader, sizeof(paddingHeader));
+         }
+
+         std::byte* record = m_data.get() + ((head + padding) & (THREAD_BUFFER_SIZE - 1));
+         const RecordHeader header = { formatId, payloadSize, timestamp };
+         std::memcpy(record, &header, sizeof(header));
+         m_pendingHead = head + padding + recordSize;
+         return record + sizeof(header);
+      }
+
+      void commit()
+      {
+         m_head.store(m_pendingHead, std::memory_order_release);
+      }
+
+      template <typename Consumer>
+      void drain(Consumer&& consume)
+      {
+         size_t tail = m_tail.load(std::memory_order_relaxed);
+         const size_t head = m_head.load(std::memory_order_acquire);
+         while (tail != head)
+         {
+            const size_t offset = tail & (THREAD_BUFFER_SIZE - 1);
+            RecordHeader header;
+            std::memcpy(&header, m_data.get() + offset, sizeof(header));
+            if (header.formatId == PADDING_RECORD)
+            {
+               tail += THREAD_BUFFER_SIZE - offset;
+               continue;
+            }
+
+            consume(header, m_data.get() + offset + sizeof(header), m_threadId);
+            tail += alignRecord(sizeof(header) + header.payloadSize);
+         }
+         m_tail.store(tail, std::memory_order_release);
+      }
+
+      std::atomic<bool> retired = false;
+      // set by the formatter thread when a drain started after retirement, only then nothing can follow
+      bool drainedAfterRetire = false;
+   private:
+      std::unique_ptr<std::byte[]> m_data;
+      const size_t m_threadId;
+      size_t m_pendingHead = 0;
+      alignas(64) std::atomic<size_t> m_head = 0;
+      alignas(64) std::atomic<size_t> m_tail = 0;
+   };
+
+   // marks the buffer as retired when its thread exits, the formatter thread frees it after draining
+   struct ThreadBufferOwner
+   {
+      std::shared_ptr<ThreadBuffer> buffer;
+
+      ~ThreadBufferOwner()
+      {
+         if (buffer)
+            buffer->retired.store(true, std::memory_order_release);
+      }
+   };
+}
+
+static std::atomic<bool> s_running = false;
+static std::atomic<uint64_t> s_droppedCount = 0;
+static std::thread s_formatterThread;
+static std::vector<spdlog::sink_ptr> s_sinks;
+
+static std::mutex s_formatsMutex;
+static std::vector<Format> s_formats;
+
+static std::mutex s_buffersMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+
+static thread_local ThreadBufferOwner t_buffer;
+
+static void formatRecord(const RecordHeader& header, const std::byte* payload, size_t threadId, fmt::dynamic_format_arg_store<fmt::format_context>& args)
+{
+   if (header.formatId >= s_formats.size())
+      return;
+
+   const Format& format = s_formats[header.formatId];
+   if (not YX_CORE_LOGGER->should_log(format.level))
+      return;
+
+   auto read = [&payload]<typename T>(T value) {
+      std::memcpy(&value, payload, sizeof(T));
+      payload += sizeof(T);
+      return value;
+   };
+
+   args.clear();
+   for (const auto type : format.argTypes)
+   {
+      switch (type)
+      {
+      case BinaryLogArg::Bool:    args.push_back(read(bool{})); break;
+      case BinaryLogArg::Int32:   args.push_back(read(int32_t{})); break;
+      case BinaryLogArg::UInt32:  args.push_back(read(uint32_t{})); break;
+      case BinaryLogArg::Int64:   args.push_back(read(int64_t{})); break;
+      case BinaryLogArg::UInt64:  args.push_back(read(uint64_t{})); break;
+      case BinaryLogArg::Float:   args.push_back(read(float{})); break;
+      case BinaryLogArg::Double:  args.push_back(read(double{})); break;
+      case BinaryLogArg::Pointer: args.push_back(read(static_cast<const void*>(nullptr))); break;
+      }
+   }
+
+   std::string text;
+   try
+   {
+      text = fmt::vformat(format.format, args);
+   }
+   catch (const fmt::format_error& e)
+   {
+      text = fmt::format("[bad binary log format \"{}\": {}]", format.format, e.what());
+   }
+
+   const auto time = spdlog::log_clock::time_point(spdlog::log_clock::duration(header.timestamp));
+   spdlog::details::log_msg message(time, spdlog::source_loc{}, "YxisBinary", format.level, text);
+   message.thread_id = threadId;
+   for (const auto& sink : s_sinks)
+   {
+      if (sink->should_log(format.level))
+         sink->log(message);
+   }
+}
+
+static void drainBuffers(std::vector<std::shared_ptr<ThreadBuffer>>& buffers, fmt::dynamic_format_arg_store<fmt::format_context>& args)
+{
+   {
+      std::lock_guard lock(s_buffersMutex);
+      buffers = s_buffers;
+   }
+
+   bool anyRetired = false;
+   {
+      std::lock_guard lock(s_formatsMutex);
+      for (const auto& buffer : buffers)
+      {
+         // load before draining, so nothing written before retirement is missed. a buffer retiring
+         // after this load may still hold records and waits for the next pass
+         if (buffer->retired.load(std::memory_order_acquire))
+         {
+            buffer->drainedAfterRetire = true;
+            anyRetired = true;
+         }
+         buffer->drain([&args](const RecordHeader& header, const std::byte* payload, size_t threadId) {
+            formatRecord(header, payload, threadId, args);
+         });
+      }
+   }
+
+   if (anyRetired)
+   {
+      std::lock_guard lock(s_buffersMutex);
+      std::erase_if(s_buffers, [](const auto& buffer) { return buffer->drainedAfterRetire; });
+   }
+}
+
+static void formatterThread()
+{
+   std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+   fmt::dynamic_format_arg_store<fmt::format_context> args;
+   while (s_running.load(std::memory_order_acquire))
+   {
+      drainBuffers(buffers, args);
+      // producers never signal, telemetry can wait a millisecond
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   drainBuffers(buffers, args);
+   for (const auto& sink : s_sinks)
+      sink->flush();
+}
+
+void BinaryLog::initialize()
+{
+   if (s_running.exchange(true))
+      return;
+
+   s_sinks = YX_CORE_LOGGER->sinks();
+   s_formatterThread = std::thread(formatterThread);
+}
+
+void BinaryLog::shutdown()
+{
+   if (not s_running.exchange(false))
+      return;
+
+   if (s_formatterThread.joinable())
+      s_formatterThread.join();
+
+   const uint64_t dropped = s_droppedCount.load(std::memory_order_relaxed);
+   if (dropped > 0)
+      YX_CORE_WARN("Binary log dropped {} records", dropped);
+}
+
+uint64_t BinaryLog::getDroppedCount()
+{
+   return s_droppedCount.load(std::memory_order_relaxed);
+}
+
+uint32_t BinaryLog::registerFormat(spdlog::level::level_enum level, const char* format, const BinaryLogArg* argTypes, uint32_t argCount)
+{
+   std::lock_guard lock(s_formatsMutex);
+   s_formats.push_back({ level, format, std::vector<BinaryLogArg>(argTypes, argTypes + argCount) });
+   return static_cast<uint32_t>(s_formats.size() - 1);
+}
+
+std::byte* BinaryLog::reserve(uint32_t formatId, uint32_t payloadSize)
+{
+   if (not s_running.load(std::memory_order_relaxed))
+      return nullptr;
+
+   if (not t_buffer.buffer)
+   {
+      t_buffer.buffer = std::make_shared<ThreadBuffer>();
+      std::lock_guard lock(s_buffersMutex);
+      s_buffers.push_back(t_buffer.buffer);
+   }
+
+   const int64_t timestamp = spdlog::log_clock::now().time_since_epoch().count();
+   std::byte* payload = t_buffer.buffer->reserve(formatId, payloadSize, timestamp);
+   if (payload == nullptr)
+      s_droppedCount.fetch_add(1, std::memory_order_relaxed);
+
+   return payload;
+}
+
+void BinaryLog::commit()
+{
+   t_buffer.buffer->commit();
+}
\ No newline at end of file
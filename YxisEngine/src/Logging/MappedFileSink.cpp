@@ -0,0 +1,123 @@
+#include "MappedFileSink.h"
+
+#ifdef YX_WINDOWS
+   #define WIN32_LEAN_AND_MEAN
+   #define NOMINMAX
+   #include <Windows.h>
+#else
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <unistd.h>
+#endif
+
+using namespace Yxis::Logging;
+
+MappedFileSink::MappedFileSink(const std::string_view baseName, const std::string_view extension, size_t segmentSize, uint32_t segmentCount)
+   : m_baseName(baseName), m_extension(extension), m_segmentSize(segmentSize), m_segmentCount(std::max(segmentCount, 1u))
+{
+   openSegment(0);
+}
+
+MappedFileSink::~MappedFileSink()
+{
+   closeSegment();
+}
+
+void MappedFileSink::sink_it_(const spdlog::details::log_msg& message)
+{
+   spdlog::memory_buf_t formatted;
+   formatter_->format(message, formatted);
+
+   const size_t size = std::min(formatted.size(), m_segmentSize);
+   if (m_view != nullptr && m_offset + size > m_segmentSize)
+   {
+      closeSegment();
+      m_segmentIndex = (m_segmentIndex + 1) % m_segmentCount;
+   }
+
+   // a segment that failed to open (disk full, no access) is retried by the next message,
+   // this one is dropped with the exception spdlog reports
+   if (m_view == nullptr)
+      openSegment(m_segmentIndex);
+
+   std::memcpy(m_view + m_offset, formatted.data(), size);
+   m_offset += size;
+}
+
+void MappedFileSink::flush_()
+{
+   // dirty pages are written back by the kernel, even if the process crashes
+}
+
+void MappedFileSink::openSegment(uint32_t index)
+{
+   closeSegment();
+
+   const std::string path = fmt::format("{}.{}{}", m_baseName, index, m_extension);
+#ifdef YX_WINDOWS
+   HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (file == INVALID_HANDLE_VALUE)
+      throw std::runtime_error(fmt::format("Failed to open log segment {}", path));
+
+   LARGE_INTEGER size;
+   size.QuadPart = static_cast<LONGLONG>(m_segmentSize);
+   HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+   void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, m_segmentSize) : nullptr;
+   if (view == nullptr)
+   {
+      if (mapping) CloseHandle(mapping);
+      CloseHandle(file);
+      throw std::runtime_error(fmt::format("Failed to map log segment {}", path));
+   }
+
+   m_file = file;
+   m_mapping = mapping;
+#else
+   const int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (file < 0)
+      throw std::runtime_error(fmt::format("Failed to open log segment {}", path));
+
+   void* view = MAP_FAILED;
+   if (ftruncate(file, static_cast<off_t>(m_segmentSize)) == 0)
+      view = mmap(nullptr, m_segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+   if (view == MAP_FAILED)
+   {
+      close(file);
+      throw std::runtime_error(fmt::format("Failed to map log segment {}", path));
+   }
+
+   m_file = file;
+#endif
+
+   m_view = static_cast<std::byte*>(view);
+   m_segmentIndex = index;
+   m_offset = 0;
+}
+
+void MappedFileSink::closeSegment()
+{
+   if (m_view == nullptr)
+      return;
+
+   // trim the preallocated tail so the file only holds what was written
+#ifdef YX_WINDOWS
+   UnmapViewOfFile(m_view);
+   CloseHandle(m_mapping);
+   LARGE_INTEGER size;
+   size.QuadPart = static_cast<LONGLONG>(m_offset);
+   SetFilePointerEx(m_file, size, nullptr, FILE_BEGIN);
+   SetEndOfFile(m_file);
+   CloseHandle(m_file);
+   m_mapping = nullptr;
+   m_file = nullptr;
+#else
+   munmap(m_view, m_segmentSize);
+   // best effort, on failure the segment just keeps its zero padding
+   [[maybe_unused]] const int result = ftruncate(m_file, static_cast<off_t>(m_offset));
+   close(m_file);
+   m_file = -1;
+#endif
+
+   m_view = nullptr;
+   m_offset = 0;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <spdlog/sinks/base_sink.h>
+
+namespace Yxis::Logging
+{
+   // File sink that appends into a memory-mapped, preallocated segment and rotates over
+   // segmentCount files (<base>.0<ext>, <base>.1<ext>, ...), overwriting the oldest one.
+   // Writing a message is a memcpy, flushing is left to the kernel. Segments are trimmed
+   // to their used size when closed; after a crash the tail of the last one is zero filled.
+   class MappedFileSink final : public spdlog::sinks::base_sink<std::mutex>
+   {
+   public:
+      MappedFileSink(const std::string_view baseName, const std::string_view extension, size_t segmentSize, uint32_t segmentCount);
+      ~MappedFileSink() override;
+   protected:
+      void sink_it_(const spdlog::details::log_msg& message) override;
+      void flush_() override;
+   private:
+      void openSegment(uint32_t index);
+      void closeSegment();
+
+      const std::string m_baseName;
+      const std::string m_extension;
+      const size_t m_segmentSize;
+      const uint32_t m_segmentCount;
+
+      uint32_t m_segmentIndex = 0;
+      size_t m_offset = 0;
+      std::byte* m_view = nullptr;
+#ifdef YX_WINDOWS
+      void* m_file = nullptr;
+      void* m_mapping = nullptr;
+#else
+      int m_file = -1;
+#endif
+   };
+}
\ No newline at end of file
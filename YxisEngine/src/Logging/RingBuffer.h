@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <bit>
+
+namespace Yxis::Logging
+{
+   // Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's algorithm).
+   // Values live in preallocated slots and are written/read in place through a callback,
+   // so slot storage (e.g. a message buffer) is reused instead of reallocated.
+   template <typename T>
+   class RingBuffer
+   {
+   public:
+      // capacity is rounded up to a power of two
+      explicit RingBuffer(size_t capacity)
+         : m_capacity(std::bit_ceil(std::max<size_t>(capacity, 2))), m_slots(std::make_unique<Slot[]>(m_capacity))
+      {
+         for (size_t i = 0; i < m_capacity; i++)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      RingBuffer(const RingBuffer&) = delete;
+      RingBuffer& operator=(const RingBuffer&) = delete;
+
+      // returns false if the buffer is full
+      template <typename Writer>
+      bool tryPush(Writer&& write)
+      {
+         size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+         Slot* slot;
+         for (;;)
+         {
+            slot = &m_slots[position & (m_capacity - 1)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0)
+            {
+               if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                  break;
+            }
+            else if (difference < 0)
+               return false;
+            else
+               position = m_enqueuePosition.load(std::memory_order_relaxed);
+         }
+
+         write(slot->value);
+         slot->sequence.store(position + 1, std::memory_order_release);
+         return true;
+      }
+
+      // returns false if the buffer is empty
+      template <typename Reader>
+      bool tryPop(Reader&& read)
+      {
+         size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+         Slot* slot;
+         for (;;)
+         {
+            slot = &m_slots[position & (m_capacity - 1)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0)
+            {
+               if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                  break;
+            }
+            else if (difference < 0)
+               return false;
+            else
+               position = m_dequeuePosition.load(std::memory_order_relaxed);
+         }
+
+         read(slot->value);
+         slot->sequence.store(position + m_capacity, std::memory_order_release);
+         return true;
+      }
+
+      size_t capacity() const { return m_capacity; }
+   private:
+      struct Slot
+      {
+         std::atomic<size_t> sequence;
+         T value;
+      };
+
+      const size_t m_capacity;
+      std::unique_ptr<Slot[]> m_slots;
+      alignas(64) std::atomic<size_t> m_enqueuePosition = 0;
+      alignas(64) std::atomic<size_t> m_dequeuePosition = 0;
+   };
+}
\ No newline at end of file
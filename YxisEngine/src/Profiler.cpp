@@ -0,0 +1,219 @@
+#include <Yxis/Profiler.h>
+#include <Yxis/Logger.h>
+#include <Yxis/CommandLine.h>
+
+namespace Yxis
+{
+   std::atomic<bool> Profiler::m_capturing = false;
+
+   struct Zone
+   {
+      const char* name;
+      uint64_t begin;
+      uint64_t end;
+   };
+
+   // written by its thread only, read by endCapture
+   struct ThreadBuffer
+   {
+      std::array<Zone, Profiler::ZONES_PER_THREAD> zones;
+      // zones ever recorded, published with release after the slot is written
+      std::atomic<uint64_t> written = 0;
+      // the rest is guarded by s_mutex
+      uint64_t captureBegin = 0;
+      uint32_t processId = 0;
+      uint32_t threadId = 0;
+      std::string name;
+   };
+
+   static constexpr uint64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+   static std::mutex s_mutex;
+   static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+   // process 0 holds the threads, tracks bring their own
+   static std::vector<std::string> s_processNames = { "Yxis" };
+   static std::string s_capturePath;
+   static uint64_t s_captureBegin = 0;
+   static const uint64_t s_frequency = SDL_GetPerformanceFrequency();
+
+   static thread_local ThreadBuffer* t_buffer = nullptr;
+   // set before the thread recorded anything, copied when its buffer is created
+   static thread_local std::string t_threadName;
+
+   static void writeZone(ThreadBuffer& buffer, const char* name, const uint64_t begin, const uint64_t end)
+   {
+      const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+      buffer.zones[index % Profiler::ZONES_PER_THREAD] = { name, begin, end };
+      buffer.written.store(index + 1, std::memory_order_release);
+   }
+
+   static ThreadBuffer* registerThread()
+   {
+      auto buffer = std::make_unique<ThreadBuffer>();
+      std::lock_guard lock(s_mutex);
+      buffer->threadId = static_cast<uint32_t>(s_buffers.size());
+      buffer->name = t_threadName.empty() ? fmt::format("Thread {}", buffer->threadId) : t_threadName;
+      return s_buffers.emplace_back(std::move(buffer)).get();
+   }
+
+   // zone names are code identifiers, but a stray quote would break the whole file
+   static void appendEscaped(fmt::memory_buffer& out, const std::string_view text)
+   {
+      for (const char c : text)
+      {
+         if (c == '"' || c == '\\')
+            out.push_back('\\');
+         if (static_cast<unsigned char>(c) >= 0x20)
+            out.push_back(c);
+      }
+   }
+
+   void Profiler::initialize()
+   {
+      setThreadName("Main thread");
+      if (const auto path = CommandLine::getOption("profile"))
+         beginCapture(path.value());
+   }
+
+   void Profiler::shutdown()
+   {
+      if (isCapturing())
+         endCapture();
+   }
+
+   void Profiler::beginCapture(const std::string_view path)
+   {
+      std::lock_guard lock(s_mutex);
+      if (isCapturing())
+      {
+         YX_CORE_LOGGER->warn("Profiler is already capturing to {}", s_capturePath);
+         return;
+      }
+
+      for (const auto& buffer : s_buffers)
+         buffer->captureBegin = buffer->written.load(std::memory_order_acquire);
+      s_capturePath = path;
+      s_captureBegin = now();
+      m_capturing.store(true, std::memory_order_relaxed);
+      YX_CORE_LOGGER->info("Profiler capture started");
+   }
+
+   void Profiler::endCapture()
+   {
+      std::lock_guard lock(s_mutex);
+      if (not isCapturing())
+         return;
+      m_capturing.store(false, std::memory_order_relaxed);
+
+      std::ofstream file(s_capturePath, std::ios::binary | std::ios::trunc);
+      if (not file)
+      {
+         YX_CORE_LOGGER->error("Failed to open profiler capture {}", s_capturePath);
+         return;
+      }
+
+      fmt::memory_buffer out;
+      fmt::format_to(std::back_inserter(out), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+      for (uint32_t processId = 0; processId < s_processNames.size(); processId++)
+      {
+         fmt::format_to(std::back_inserter(out), "{}{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},\"tid\":0,\"args\":{{\"name\":\"", processId == 0 ? "" : ",\n", processId);
+         appendEscaped(out, s_processNames[processId]);
+         fmt::format_to(std::back_inserter(out), "\"}}}}");
+      }
+
+      uint64_t zoneCount = 0;
+      uint64_t droppedCount = 0;
+      for (const auto& buffer : s_buffers)
+      {
+         fmt::format_to(std::back_inserter(out), ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":\"", buffer->processId, buffer->threadId);
+         appendEscaped(out, buffer->name);
+         fmt::format_to(std::back_inserter(out), "\"}}}}");
+
+         // a zone that passed the capture check just before it ended may still land in the oldest slot
+         const uint64_t written = buffer->written.load(std::memory_order_acquire);
+         const uint64_t oldest = written + 1 > ZONES_PER_THREAD ? written + 1 - ZONES_PER_THREAD : 0;
+         const uint64_t first = std::max(buffer->captureBegin, oldest);
+         droppedCount += first - buffer->captureBegin;
+
+         for (uint64_t i = first; i < written; i++)
+         {
+            const Zone& zone = buffer->zones[i % ZONES_PER_THREAD];
+            fmt::format_to(std::back_inserter(out), ",\n{{\"name\":\"");
+            appendEscaped(out, zone.name);
+            // microseconds with nanosecond precision
+            fmt::format_to(std::back_inserter(out), "\",\"ph\":\"X\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+               buffer->processId, buffer->threadId, (static_cast<int64_t>(zone.begin) - static_cast<int64_t>(s_captureBegin)) / 1000.0, (zone.end - zone.begin) / 1000.0);
+            zoneCount++;
+         }
+
+         if (out.size() > 1024 * 1024)
+         {
+            file.write(out.data(), out.size());
+            out.clear();
+         }
+      }
+
+      fmt::format_to(std::back_inserter(out), "\n]}}\n");
+      file.write(out.data(), out.size());
+
+      YX_CORE_LOGGER->info("Profiler capture written to {}, {} zones", s_capturePath, zoneCount);
+      if (droppedCount != 0)
+         YX_CORE_LOGGER->warn("Profiler dropped {} zones, more than {} per thread", droppedCount, ZONES_PER_THREAD);
+   }
+
+   void Profiler::setThreadName(const std::string_view name)
+   {
+      t_threadName = name;
+      if (t_buffer)
+      {
+         std::lock_guard lock(s_mutex);
+         t_buffer->name = t_threadName;
+      }
+   }
+
+   uint32_t Profiler::createTrack(const std::string_view process, const std::string_view name)
+   {
+      auto buffer = std::make_unique<ThreadBuffer>();
+      std::lock_guard lock(s_mutex);
+      auto processName = std::find(s_processNames.begin(), s_processNames.end(), process);
+      if (processName == s_processNames.end())
+         processName = s_processNames.emplace(s_processNames.end(), process);
+
+      buffer->processId = static_cast<uint32_t>(processName - s_processNames.begin());
+      buffer->threadId = static_cast<uint32_t>(s_buffers.size());
+      buffer->name = name;
+      s_buffers.emplace_back(std::move(buffer));
+      return static_cast<uint32_t>(s_buffers.size() - 1);
+   }
+
+   uint64_t Profiler::now() noexcept
+   {
+      return toNanoseconds(SDL_GetPerformanceCounter());
+   }
+
+   uint64_t Profiler::toNanoseconds(const uint64_t ticks) noexcept
+   {
+      if (s_frequency == NANOSECONDS_PER_SECOND)
+         return ticks;
+      return ticks / s_frequency * NANOSECONDS_PER_SECOND + ticks % s_frequency * NANOSECONDS_PER_SECOND / s_frequency;
+   }
+
+   void Profiler::record(const char* name, const uint64_t begin, const uint64_t end) noexcept
+   {
+      if (t_buffer == nullptr)
+      {
+         try { t_buffer = registerThread(); }
+         catch (...) { return; }
+      }
+
+      writeZone(*t_buffer, name, begin, end);
+   }
+
+   void Profiler::recordOnTrack(const uint32_t track, const char* name, const uint64_t begin, const uint64_t end) noexcept
+   {
+      // tracks are filled in batches (query readback), a lock per zone is fine there
+      std::lock_guard lock(s_mutex);
+      if (isCapturing() && track < s_buffers.size())
+         writeZone(*s_buffers[track], name, begin, end);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "FileRead.h"
+#include "../File.h"
+
+using namespace Yxis::Tasks;
+
+void FileRead::await_suspend(const std::coroutine_handle<> handle)
+{
+   // the awaiter lives in the suspended coroutine's frame until it's resumed
+   JobSystem::run([this, handle]() {
+      try
+      {
+         auto data = File::readAll(m_path);
+         if (not data)
+            throw std::runtime_error(fmt::format("Failed to read {}", m_path.string()));
+         m_data = std::move(*data);
+      }
+      catch (...)
+      {
+         m_error = std::current_exception();
+      }
+      handle.resume();
+   });
+}
+
+std::vector<std::byte> FileRead::await_resume()
+{
+   if (m_error)
+      std::rethrow_exception(m_error);
+   return std::move(m_data);
+}
\ No newline at end of file
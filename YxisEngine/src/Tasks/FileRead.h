@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Task.h"
+#include <filesystem>
+
+namespace Yxis::Tasks
+{
+   // co_await FileRead(path) reads the whole file on a job system worker, the coroutine continues there.
+   // Throws std::runtime_error from the co_await if the file can't be read.
+   class FileRead
+   {
+   public:
+      explicit FileRead(std::filesystem::path path) : m_path(std::move(path)) {}
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(const std::coroutine_handle<> handle);
+      std::vector<std::byte> await_resume();
+   private:
+      const std::filesystem::path m_path;
+      std::vector<std::byte> m_data;
+      std::exception_ptr m_error;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <Yxis/JobSystem.h>
+#include <Yxis/Logger.h>
+#include <coroutine>
+
+namespace Yxis::Tasks
+{
+   template <typename T = void>
+   class Task;
+
+   namespace Detail
+   {
+      struct PromiseBase
+      {
+         std::coroutine_handle<> continuation;
+         std::exception_ptr exception;
+         // started with Task::start(), nobody awaits it and the frame frees itself
+         bool detached = false;
+
+         struct FinalAwaiter
+         {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+               PromiseBase& promise = handle.promise();
+               if (promise.detached)
+               {
+                  if (promise.exception)
+                  {
+                     try { std::rethrow_exception(promise.exception); }
+                     catch (const std::exception& e) { YX_CORE_LOGGER->error("Detached task failed: {}", e.what()); }
+                     catch (...) { YX_CORE_LOGGER->error("Detached task failed"); }
+                  }
+                  handle.destroy();
+                  return std::noop_coroutine();
+               }
+
+               // symmetric transfer straight into the awaiting coroutine
+               return promise.continuation ? promise.continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+         };
+
+         std::suspend_always initial_suspend() const noexcept { return {}; }
+         FinalAwaiter final_suspend() const noexcept { return {}; }
+         void unhandled_exception() { exception = std::current_exception(); }
+      };
+
+      template <typename T>
+      struct Promise : PromiseBase
+      {
+         std::optional<T> value;
+
+         Task<T> get_return_object();
+         void return_value(T result) { value.emplace(std::move(result)); }
+
+         T result()
+         {
+            if (exception)
+               std::rethrow_exception(exception);
+            return std::move(value.value());
+         }
+      };
+
+      template <>
+      struct Promise<void> : PromiseBase
+      {
+         Task<void> get_return_object();
+         void return_void() {}
+
+         void result()
+         {
+            if (exception)
+               std::rethrow_exception(exception);
+         }
+      };
+
+      // co_await that only waits for the task to finish, the result stays in its promise
+      template <typename Promise>
+      struct CompletionAwaiter
+      {
+         std::coroutine_handle<Promise> handle;
+
+         bool await_ready() const noexcept { return handle.done(); }
+         std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+         {
+            handle.promise().continuation = awaiting;
+            return handle;
+         }
+         void await_resume() const noexcept {}
+      };
+   }
+
+   template <typename T>
+   T syncWait(Task<T> task);
+
+   // Lazily started coroutine. co_await it from another task (starts it and resumes the awaiter
+   // when it's done, exceptions included) or start() it on the job system and let it run on its own.
+   // Tasks can co_await other tasks, ResumeOnWorker, FileRead and TimelineSemaphore::waitAsync,
+   // code outside of tasks gets the result with syncWait().
+   template <typename T>
+   class [[nodiscard]] Task
+   {
+   public:
+      using promise_type = Detail::Promise<T>;
+      using Handle = std::coroutine_handle<promise_type>;
+
+      explicit Task(const Handle handle) : m_handle(handle) {}
+      Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+      Task& operator=(Task&& other) noexcept
+      {
+         if (this != &other)
+         {
+            if (m_handle)
+               m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+         }
+         return *this;
+      }
+      ~Task()
+      {
+         if (m_handle)
+            m_handle.destroy();
+      }
+
+      Task(const Task&) = delete;
+      Task& operator=(const Task&) = delete;
+
+      auto operator co_await() const noexcept
+      {
+         struct Awaiter
+         {
+            Handle handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+            {
+               handle.promise().continuation = awaiting;
+               return handle;
+            }
+            T await_resume() { return handle.promise().result(); }
+         };
+         return Awaiter{ m_handle };
+      }
+
+      // runs the task on a job system worker, errors are logged
+      void start() &&
+      {
+         const Handle handle = std::exchange(m_handle, {});
+         handle.promise().detached = true;
+         JobSystem::run([handle]() { handle.resume(); });
+      }
+   private:
+      template <typename U>
+      friend U syncWait(Task<U> task);
+
+      Handle m_handle;
+   };
+
+   template <typename T>
+   Task<T> Detail::Promise<T>::get_return_object()
+   {
+      return Task<T>(Task<T>::Handle::from_promise(*this));
+   }
+
+   inline Task<void> Detail::Promise<void>::get_return_object()
+   {
+      return Task<void>(Task<void>::Handle::from_promise(*this));
+   }
+
+   namespace Detail
+   {
+      template <typename Promise>
+      Task<void> releaseWhenDone(const std::coroutine_handle<Promise> handle, JobCounter& done)
+      {
+         co_await CompletionAwaiter<Promise>{ handle };
+         JobSystem::release(done);
+      }
+   }
+
+   // Blocks until the task finished and returns its result or rethrows its exception, for code that
+   // isn't a coroutine. The calling thread runs other jobs meanwhile, like JobSystem::wait.
+   template <typename T>
+   T syncWait(Task<T> task)
+   {
+      JobCounter done;
+      JobSystem::retain(done);
+      Detail::releaseWhenDone(task.m_handle, done).start();
+      JobSystem::wait(done);
+      return task.m_handle.promise().result();
+   }
+
+   // co_await ResumeOnWorker{} moves the rest of the coroutine onto a job system worker
+   struct ResumeOnWorker
+   {
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(const std::coroutine_handle<> handle) const { JobSystem::run([handle]() { handle.resume(); }); }
+      void await_resume() const noexcept {}
+   };
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "TaskTest.h"
+#include "FileRead.h"
+#include "../Vulkan/VulkanRenderer.h"
+
+using namespace Yxis::Tasks;
+
+static constexpr uint32_t NESTING_DEPTH = 16;
+static constexpr size_t TEST_FILE_SIZE = 64 * 1024;
+static constexpr std::string_view TEST_FILE_PATH = "task_test.bin";
+
+// every level moves to a worker first, the sum comes back through NESTING_DEPTH continuations
+static Task<uint32_t> sumOnWorkers(const uint32_t depth)
+{
+   co_await ResumeOnWorker{};
+   if (depth == 0)
+      co_return 0;
+   co_return depth + co_await sumOnWorkers(depth - 1);
+}
+
+static Task<void> failOnWorker()
+{
+   co_await ResumeOnWorker{};
+   throw std::runtime_error("expected failure");
+}
+
+static Task<bool> awaitFailure()
+{
+   try
+   {
+      co_await failOnWorker();
+   }
+   catch (const std::runtime_error&)
+   {
+      co_return true;
+   }
+   co_return false;
+}
+
+static Task<std::vector<std::byte>> readFile(const std::filesystem::path path)
+{
+   co_return co_await FileRead(path);
+}
+
+static Task<uint64_t> awaitTimeline(const Yxis::Vulkan::TimelineSemaphore& semaphore, const uint64_t value)
+{
+   co_await semaphore.waitAsync(value);
+   co_return value;
+}
+
+static bool testNesting()
+{
+   const uint32_t sum = syncWait(sumOnWorkers(NESTING_DEPTH));
+   return sum == NESTING_DEPTH * (NESTING_DEPTH + 1) / 2;
+}
+
+static bool testFileRead()
+{
+   std::vector<std::byte> written(TEST_FILE_SIZE);
+   for (size_t i = 0; i < written.size(); i++)
+      written[i] = static_cast<std::byte>(i * 31);
+   {
+      std::ofstream file(std::string(TEST_FILE_PATH), std::ios::binary);
+      file.write(reinterpret_cast<const char*>(written.data()), written.size());
+   }
+
+   const std::vector<std::byte> read = syncWait(readFile(TEST_FILE_PATH));
+   std::filesystem::remove(TEST_FILE_PATH);
+   return read == written;
+}
+
+static bool testTimeline()
+{
+   using namespace Yxis::Vulkan;
+   TimelineSemaphore semaphore(VulkanRenderer::getDevice().get(), 0);
+
+   // signalled from the host once the task most likely sits in the TimelineWaiter
+   std::thread signaller([&semaphore]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      semaphore.signal(1);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      semaphore.signal(2);
+   });
+
+   const uint64_t first = syncWait(awaitTimeline(semaphore, 1));
+   const uint64_t second = syncWait(awaitTimeline(semaphore, 2));
+   signaller.join();
+   return first == 1 && second == 2;
+}
+
+void Yxis::Tasks::runTaskTest()
+{
+   const std::pair<const char*, bool(*)()> tests[] =
+   {
+      { "nested tasks", testNesting },
+      { "exception through co_await", []() { return syncWait(awaitFailure()); } },
+      { "FileRead", testFileRead },
+      { "timeline semaphore", testTimeline },
+   };
+
+   uint32_t failed = 0;
+   for (const auto& [name, test] : tests)
+   {
+      bool passed = false;
+      try
+      {
+         passed = test();
+      }
+      catch (const std::exception& e)
+      {
+         YX_CORE_LOGGER->error("Task test {} threw: {}", name, e.what());
+      }
+
+      if (not passed)
+         failed++;
+      YX_CORE_LOGGER->info("Task test {}: {}", name, passed ? "passed" : "FAILED");
+   }
+
+   if (failed != 0)
+      YX_CORE_LOGGER->error("{} task tests failed", failed);
+}
\ No newline at end of file
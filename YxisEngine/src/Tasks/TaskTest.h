@@ -0,0 +1,9 @@
+#pragma once
+
+namespace Yxis::Tasks
+{
+   // Exercises the task machinery end to end once the device exists: nested tasks hopping onto workers,
+   // an exception crossing a co_await, a FileRead and a timeline value signalled from another thread.
+   // Results go to the core log. --task-test, best with --headless --max-frames=1
+   void runTaskTest();
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Device.h"
 #include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
 #include "../Window.h"
 #include "VulkanRenderer.h"
 
@@ -12,25 +13,67 @@
 using namespace Yxis::Vulkan;
 using QueueFlags = std::bitset<32>;
 
-static constexpr VmaAllocatorCreateFlags allcatorEnabledExtensions =
-   VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT |
-   VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE4_BIT |
-   VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE5_BIT |
-   VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT |
-   VMA_ALLOCATOR_CREATE_EXT_MEMORY_PRIORITY_BIT;
+static constexpr VmaAllocatorCreateFlags allcatorEnabledExtensions = VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT;
+
+static constexpr const char* REQUIRED_DEVICE_EXTENSIONS[] = {
+   VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+   VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+};
+
+// skipped when the driver doesn't have them (software drivers like lavapipe lack most of these)
+static constexpr const char* OPTIONAL_DEVICE_EXTENSIONS[] = {
+   VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME,
+   VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+   VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME,
+   VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME,
+};
+
+static constexpr uint32_t HEADLESS_IMAGE_COUNT = 3;
 
 Device::Device(VkPhysicalDevice physicalDevice)
    : m_physicalDevice(physicalDevice)
 {
+   YX_PROFILE_SCOPE("Device::Device");
    constexpr std::array<const char*, 0> deviceEnabledLayers = {};
-   constexpr const char* deviceEnabledExtensions[] = { 
-      VK_KHR_SWAPCHAIN_EXTENSION_NAME,
-      VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
-      VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME,
-      VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
-      VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
-      VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME,
-   };
+
+   // extensions
+   {
+      uint32_t extensionsCount;
+      vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionsCount, nullptr);
+      std::vector<VkExtensionProperties> availableExtensions(extensionsCount);
+      vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionsCount, availableExtensions.data());
+
+      auto isAvailable = [&](const char* extensionName) {
+         return std::any_of(availableExtensions.begin(), availableExtensions.end(), [&](const VkExtensionProperties& properties) {
+            return std::strcmp(properties.extensionName, extensionName) == 0;
+            });
+      };
+
+      std::vector<const char*> requiredExtensions(std::begin(REQUIRED_DEVICE_EXTENSIONS), std::end(REQUIRED_DEVICE_EXTENSIONS));
+      if (not Window::isHeadless())
+         requiredExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+      for (const char* extensionName : requiredExtensions)
+      {
+         if (not isAvailable(extensionName))
+            throw std::runtime_error(fmt::format("Required device extension {} is not supported", extensionName));
+         m_enabledExtensions.push_back(extensionName);
+      }
+
+      for (const char* extensionName : OPTIONAL_DEVICE_EXTENSIONS)
+      {
+         if (isAvailable(extensionName))
+            m_enabledExtensions.push_back(extensionName);
+         else
+            YX_CORE_LOGGER->info("Optional device extension {} is not supported, skipping", extensionName);
+      }
+
+      // older drivers only have the EXT version of calibrated timestamps, GpuClock takes either
+      if (not isExtensionEnabled(VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) && isAvailable(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+         m_enabledExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+   }
+
+   uint32_t graphicsFamilyQueueCount = 1;
 
    // queues
    {
@@ -50,6 +93,7 @@ Device::Device(VkPhysicalDevice physicalDevice)
             if (testQueueFlags(properties.queueFlags, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) // graphics doesn't need to advertise VK_QUEUE_TRANSFER_BIT (link below)
             {
                m_queues.graphics.familyIndex = i;
+               graphicsFamilyQueueCount = properties.queueCount;
                m_queues.graphics.queues.resize(1); // at least 1
             }
 
@@ -77,6 +121,8 @@ Device::Device(VkPhysicalDevice physicalDevice)
       }
    }
    
+   VmaAllocatorCreateFlags allocatorFlags = allcatorEnabledExtensions;
+   uint32_t deviceApiVersion = VK_API_VERSION_1_3;
    {
       static constexpr float QUEUE_PRIORITY = 1.0f;
       // https://community.khronos.org/t/question-about-queue-families/108131/2
@@ -90,7 +136,9 @@ Device::Device(VkPhysicalDevice physicalDevice)
             return;
          }
 
-         queuesCreateInfos[0].queueCount++;
+         // single queue families (lavapipe) share the one gfx queue
+         if (queuesCreateInfos[0].queueCount < graphicsFamilyQueueCount)
+            queuesCreateInfos[0].queueCount++;
       };
 
       enableDedicatedQueue(m_queues.compute, 1);
@@ -112,9 +160,20 @@ Device::Device(VkPhysicalDevice physicalDevice)
       VkPhysicalDeviceVulkan12Features vulkan12Features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, &vulkan11Features };
       VkPhysicalDeviceVulkan13Features vulkan13Features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES, &vulkan12Features };
       VkPhysicalDeviceVulkan14Features vulkan14Features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_4_FEATURES, &vulkan13Features };
-      VkPhysicalDeviceFeatures2 features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &vulkan14Features };
+      // 1.4 features can only be chained on 1.4 devices
+      deviceApiVersion = std::min(properties.properties.apiVersion, VK_API_VERSION_1_4);
+      VkPhysicalDeviceFeatures2 features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, deviceApiVersion >= VK_API_VERSION_1_4 ? static_cast<void*>(&vulkan14Features) : &vulkan13Features };
       vkGetPhysicalDeviceFeatures2(m_physicalDevice, &features);
 
+      if (vulkan13Features.maintenance4)
+         allocatorFlags |= VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE4_BIT;
+      if (deviceApiVersion >= VK_API_VERSION_1_4 && vulkan14Features.maintenance5)
+         allocatorFlags |= VMA_ALLOCATOR_CREATE_KHR_MAINTENANCE5_BIT;
+      if (isExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+         allocatorFlags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+      if (isExtensionEnabled(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME))
+         allocatorFlags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_PRIORITY_BIT;
+
       VkDeviceCreateInfo deviceCreateInfo =
       {
          .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
@@ -124,8 +183,8 @@ Device::Device(VkPhysicalDevice physicalDevice)
          .pQueueCreateInfos = queuesCreateInfos.data(),
          .enabledLayerCount = static_cast<uint32_t>(deviceEnabledLayers.size()),
          .ppEnabledLayerNames = deviceEnabledLayers.data(),
-         .enabledExtensionCount = static_cast<uint32_t>(std::size(deviceEnabledExtensions)),
-         .ppEnabledExtensionNames = deviceEnabledExtensions,
+         .enabledExtensionCount = static_cast<uint32_t>(m_enabledExtensions.size()),
+         .ppEnabledExtensionNames = m_enabledExtensions.data(),
       };
 
       VkResult result = vkCreateDevice(m_physicalDevice, &deviceCreateInfo, nullptr, &m_device);
@@ -174,12 +233,12 @@ Device::Device(VkPhysicalDevice physicalDevice)
 
       const VmaAllocatorCreateInfo allocatorCreateInfo =
       {
-         .flags = allcatorEnabledExtensions,
+         .flags = allocatorFlags,
          .physicalDevice = m_physicalDevice,
          .device = m_device,
          .pVulkanFunctions = &vulkanFunctions,
          .instance = VulkanRenderer::getInstance(),
-         .vulkanApiVersion = VK_API_VERSION_1_4,
+         .vulkanApiVersion = VK_MAKE_API_VERSION(0, VK_API_VERSION_MAJOR(deviceApiVersion), VK_API_VERSION_MINOR(deviceApiVersion), 0),
       };
 
       VkResult result = vmaCreateAllocator(&allocatorCreateInfo, &m_memoryManager.allocator);
@@ -187,7 +246,14 @@ Device::Device(VkPhysicalDevice physicalDevice)
          throw std::runtime_error(fmt::format("Failed to create memory allocator. {}", string_VkResult(result)));
    }
 
-   m_swapchain = std::make_unique<Swapchain>(this);
+   m_timelineWaiter = std::make_unique<TimelineWaiter>(this);
+   m_gpuClock = std::make_unique<GpuClock>(this);
+   m_gpuProfiler = std::make_unique<GpuProfiler>(this);
+
+   if (Window::isHeadless())
+      m_offscreenTarget = std::make_unique<OffscreenTarget>(this, Window::getExtent(), HEADLESS_IMAGE_COUNT);
+   else
+      m_swapchain = std::make_unique<Swapchain>(this);
 }
 
 Device::operator VkDevice() const
@@ -248,23 +314,38 @@ const std::vector<VkSurfaceFormat2KHR> Device::getSurfaceFormats() const
 
 const std::vector<VkPresentModeKHR> Device::getPresentModes() const
 {
+   // the 2EXT variant belongs to VK_EXT_full_screen_exclusive (windows only), the core query works everywhere
    uint32_t presentModesCount;
-   const VkPhysicalDeviceSurfaceInfo2KHR surfaceInfo =
-   {
-      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SURFACE_INFO_2_KHR,
-      .pNext = nullptr,
-      .surface = Window::getSurface(),
-   };
-
-   vkGetPhysicalDeviceSurfacePresentModes2EXT(m_physicalDevice, &surfaceInfo, &presentModesCount, nullptr);
+   const VkSurfaceKHR surface = Window::getSurface();
+   vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, surface, &presentModesCount, nullptr);
    std::vector<VkPresentModeKHR> presentModes(presentModesCount);
-   VkResult result = vkGetPhysicalDeviceSurfacePresentModes2EXT(m_physicalDevice, &surfaceInfo, &presentModesCount, presentModes.data());
+   VkResult result = vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, surface, &presentModesCount, presentModes.data());
    if (result != VK_SUCCESS)
       throw std::runtime_error(fmt::format("Failed to get available present modes. {}", string_VkResult(result)));
 
    return presentModes;
 }
 
+bool Device::isExtensionEnabled(const std::string_view extensionName) const
+{
+   return std::any_of(m_enabledExtensions.begin(), m_enabledExtensions.end(), [&](const char* enabled) { return extensionName == enabled; });
+}
+
+const Swapchain* Device::getSwapchain() const
+{
+   return m_swapchain.get();
+}
+
+Swapchain* Device::getSwapchain()
+{
+   return m_swapchain.get();
+}
+
+const OffscreenTarget* Device::getOffscreenTarget() const
+{
+   return m_offscreenTarget.get();
+}
+
 const Queues& Device::getDeviceQueues() const
 {
    return m_queues;
@@ -275,6 +356,21 @@ const TimelineSemaphore Device::createTimelineSemaphore() const
    return TimelineSemaphore(this, 0);
 }
 
+TimelineWaiter& Device::getTimelineWaiter() const
+{
+   return *m_timelineWaiter;
+}
+
+GpuClock& Device::getGpuClock() const
+{
+   return *m_gpuClock;
+}
+
+GpuProfiler& Device::getGpuProfiler() const
+{
+   return *m_gpuProfiler;
+}
+
 const VmaAllocator Device::getAllocator() const
 {
    return m_memoryManager.allocator;
@@ -282,7 +378,13 @@ const VmaAllocator Device::getAllocator() const
 
 Device::~Device()
 {
+   m_timelineWaiter.reset();
+   m_gpuProfiler.reset();
+   m_gpuClock.reset();
    m_swapchain.reset();
+   m_offscreenTarget.reset();
+   if (m_memoryManager.allocator != VK_NULL_HANDLE)
+      vmaDestroyAllocator(m_memoryManager.allocator);
    if (m_device != VK_NULL_HANDLE)
       vkDestroyDevice(m_device, nullptr);
 }
\ No newline at end of file
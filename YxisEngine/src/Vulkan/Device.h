@@ -2,7 +2,10 @@
 
 #include "../internal_pch.h"
 #include "Swapchain.h"
+#include "OffscreenTarget.h"
 #include "TimelineSemaphore.h"
+#include "GpuClock.h"
+#include "GpuProfiler.h"
 #include "vk_mem_alloc.h"
 
 namespace Yxis::Vulkan
@@ -41,12 +44,23 @@ namespace Yxis::Vulkan
       const VkSurfaceCapabilities2KHR getSurfaceCapabilities() const;
       const std::vector<VkSurfaceFormat2KHR> getSurfaceFormats() const;
       const std::vector<VkPresentModeKHR> getPresentModes() const;
+      bool isExtensionEnabled(const std::string_view extensionName) const;
+
+      // exactly one of these exists, the offscreen target when running headless
+      const Swapchain* getSwapchain() const;
+      Swapchain* getSwapchain();
+      const OffscreenTarget* getOffscreenTarget() const;
 
       // queues
       const Queues& getDeviceQueues() const;
 
       // synchronization
       const TimelineSemaphore createTimelineSemaphore() const;
+      TimelineWaiter& getTimelineWaiter() const;
+
+      // profiling
+      GpuClock& getGpuClock() const;
+      GpuProfiler& getGpuProfiler() const;
 
       // memory
       const VmaAllocator getAllocator() const;
@@ -56,10 +70,15 @@ namespace Yxis::Vulkan
       VkPhysicalDevice m_physicalDevice;
 
       struct {
-         VmaAllocator allocator;
+         VmaAllocator allocator = VK_NULL_HANDLE;
       } m_memoryManager;
 
+      std::vector<const char*> m_enabledExtensions;
       std::unique_ptr<Swapchain> m_swapchain;
+      std::unique_ptr<OffscreenTarget> m_offscreenTarget;
+      std::unique_ptr<TimelineWaiter> m_timelineWaiter;
+      std::unique_ptr<GpuClock> m_gpuClock;
+      std::unique_ptr<GpuProfiler> m_gpuProfiler;
       Queues m_queues;
    };
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "GpuClock.h"
+#include "Device.h"
+#include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
+
+using namespace Yxis::Vulkan;
+
+// the domain SDL_GetPerformanceCounter reads: QueryPerformanceCounter on windows, CLOCK_MONOTONIC_RAW elsewhere
+#ifdef YX_WINDOWS
+static constexpr VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_KHR;
+#else
+static constexpr VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_KHR;
+#endif
+
+GpuClock::GpuClock(const Device* device)
+   : m_device(device)
+{
+   const VkPhysicalDevice physicalDevice = m_device->getPhysicalDevice();
+   VkPhysicalDeviceProperties properties;
+   vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+   uint32_t familyCount;
+   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+   std::vector<VkQueueFamilyProperties> families(familyCount);
+   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+   if (properties.limits.timestampPeriod == 0.0f || families[m_device->getDeviceQueues().graphics.familyIndex].timestampValidBits == 0)
+      return;
+   m_timestampPeriod = properties.limits.timestampPeriod;
+   m_available = true;
+
+   // the KHR extension is the promoted EXT one, same functions and structures
+   PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR getTimeDomains = nullptr;
+   if (m_device->isExtensionEnabled(VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+   {
+      getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsKHR;
+      m_getCalibratedTimestamps = vkGetCalibratedTimestampsKHR;
+   }
+   else if (m_device->isExtensionEnabled(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+   {
+      getTimeDomains = vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+      m_getCalibratedTimestamps = vkGetCalibratedTimestampsEXT;
+   }
+
+   if (getTimeDomains)
+   {
+      uint32_t domainCount;
+      getTimeDomains(physicalDevice, &domainCount, nullptr);
+      std::vector<VkTimeDomainKHR> domains(domainCount);
+      getTimeDomains(physicalDevice, &domainCount, domains.data());
+
+      const bool hasDevice = std::find(domains.begin(), domains.end(), VK_TIME_DOMAIN_DEVICE_KHR) != domains.end();
+      const bool hasHost = std::find(domains.begin(), domains.end(), HOST_TIME_DOMAIN) != domains.end();
+      if (not hasDevice || not hasHost)
+      {
+         YX_CORE_LOGGER->info("Calibrated timestamps don't cover the device and {} time domains", string_VkTimeDomainKHR(HOST_TIME_DOMAIN));
+         m_getCalibratedTimestamps = nullptr;
+      }
+   }
+
+   if (m_getCalibratedTimestamps)
+      YX_CORE_LOGGER->info("GPU clock calibrates against {}, resampled every {} ms while capturing", string_VkTimeDomainKHR(HOST_TIME_DOMAIN), CALIBRATION_INTERVAL / 1'000'000);
+}
+
+bool GpuClock::isAvailable() const
+{
+   return m_available;
+}
+
+bool GpuClock::isCalibrated() const
+{
+   return m_getCalibratedTimestamps != nullptr;
+}
+
+bool GpuClock::isSynchronized() const
+{
+   return m_synchronized;
+}
+
+void GpuClock::update()
+{
+   // nothing is mapped outside of captures, so no gpu work happens unless somebody profiles
+   if (not m_available || not Profiler::isCapturing())
+      return;
+
+   if (m_synchronized)
+   {
+      if (m_getCalibratedTimestamps && Profiler::now() - m_lastSampleTime >= CALIBRATION_INTERVAL)
+         sample();
+      return;
+   }
+
+   if (m_getCalibratedTimestamps)
+      sample();
+
+   // the first sample can fail the deviation check too
+   if (m_sampleCount > 0)
+   {
+      m_synchronized = true;
+      return;
+   }
+
+   m_getCalibratedTimestamps = nullptr;
+   try
+   {
+      synchronizeOnce();
+      m_synchronized = true;
+      YX_CORE_LOGGER->info("GPU clock synchronized once, drift isn't tracked");
+   }
+   catch (const std::exception& e)
+   {
+      // a profiling aid, the renderer carries on without gpu zones
+      YX_CORE_LOGGER->error("{}, GPU zones are disabled", e.what());
+      m_available = false;
+   }
+}
+
+uint64_t GpuClock::toProfilerTime(const uint64_t gpuTicks) const
+{
+   const double gpuNanoseconds = static_cast<double>(static_cast<int64_t>(gpuTicks - m_reference.gpuTicks)) * m_timestampPeriod;
+   return m_reference.cpuTime + static_cast<int64_t>(m_intercept + m_slope * gpuNanoseconds);
+}
+
+void GpuClock::sample()
+{
+   m_lastSampleTime = Profiler::now();
+
+   const std::array<VkCalibratedTimestampInfoKHR, 2> infos =
+   { {
+      { .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_DEVICE_KHR },
+      { .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR, .pNext = nullptr, .timeDomain = HOST_TIME_DOMAIN },
+   } };
+   std::array<uint64_t, 2> timestamps;
+   uint64_t maxDeviation;
+
+   VkResult result = m_getCalibratedTimestamps(m_device->getLogicalDevice(), static_cast<uint32_t>(infos.size()), infos.data(), timestamps.data(), &maxDeviation);
+   if (result != VK_SUCCESS)
+   {
+      YX_CORE_LOGGER->warn("Failed to sample calibrated timestamps. {}", string_VkResult(result));
+      return;
+   }
+   if (maxDeviation > MAX_DEVIATION)
+   {
+      YX_CORE_TRACE("Calibrated timestamp sample dropped, deviation {} ns", maxDeviation);
+      return;
+   }
+
+   m_samples[m_nextSample] = { timestamps[0], Profiler::toNanoseconds(timestamps[1]) };
+   m_nextSample = (m_nextSample + 1) % SAMPLE_COUNT;
+   m_sampleCount = std::min(m_sampleCount + 1, SAMPLE_COUNT);
+   fit();
+}
+
+void GpuClock::fit()
+{
+   // least squares through the samples, relative to the newest one so the doubles keep their precision
+   m_reference = m_samples[(m_nextSample + SAMPLE_COUNT - 1) % SAMPLE_COUNT];
+
+   double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+   for (uint32_t i = 0; i < m_sampleCount; i++)
+   {
+      const double x = static_cast<double>(static_cast<int64_t>(m_samples[i].gpuTicks - m_reference.gpuTicks)) * m_timestampPeriod;
+      const double y = static_cast<double>(static_cast<int64_t>(m_samples[i].cpuTime - m_reference.cpuTime));
+      sumX += x;
+      sumY += y;
+      sumXX += x * x;
+      sumXY += x * y;
+   }
+
+   const double count = m_sampleCount;
+   const double denominator = count * sumXX - sumX * sumX;
+   if (m_sampleCount < 2 || denominator <= 0.0)
+   {
+      m_slope = 1.0;
+      m_intercept = 0.0;
+      return;
+   }
+
+   m_slope = (count * sumXY - sumX * sumY) / denominator;
+   m_intercept = (sumY - m_slope * sumX) / count;
+   YX_CORE_TRACE("GPU clock drift {:.2f} ppm over {} samples", (m_slope - 1.0) * 1e6, m_sampleCount);
+}
+
+void GpuClock::synchronizeOnce()
+{
+   // one timestamp written by the gpu and the cpu clock read as soon as the queue drained.
+   // the wakeup latency ends up as a constant offset of everything mapped
+   const VkDevice device = m_device->getLogicalDevice();
+   const Queue& graphics = m_device->getDeviceQueues().graphics;
+
+   const VkQueryPoolCreateInfo queryPoolCreateInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .queryType = VK_QUERY_TYPE_TIMESTAMP,
+      .queryCount = 1,
+      .pipelineStatistics = 0,
+   };
+
+   VkQueryPool queryPool;
+   VkResult result = vkCreateQueryPool(device, &queryPoolCreateInfo, nullptr, &queryPool);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to create query pool for GPU clock synchronization. {}", string_VkResult(result)));
+
+   const VkCommandPoolCreateInfo commandPoolCreateInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+      .queueFamilyIndex = graphics.familyIndex,
+   };
+
+   VkCommandPool commandPool;
+   result = vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &commandPool);
+   if (result != VK_SUCCESS)
+   {
+      vkDestroyQueryPool(device, queryPool, nullptr);
+      throw std::runtime_error(fmt::format("Failed to create command pool for GPU clock synchronization. {}", string_VkResult(result)));
+   }
+
+   const VkCommandBufferAllocateInfo allocateInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .pNext = nullptr,
+      .commandPool = commandPool,
+      .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+      .commandBufferCount = 1,
+   };
+
+   VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+   result = vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+   if (result == VK_SUCCESS)
+   {
+      const VkCommandBufferBeginInfo beginInfo =
+      {
+         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+         .pNext = nullptr,
+         .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+         .pInheritanceInfo = nullptr,
+      };
+      vkBeginCommandBuffer(commandBuffer, &beginInfo);
+      vkCmdResetQueryPool(commandBuffer, queryPool, 0, 1);
+      vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, queryPool, 0);
+      result = vkEndCommandBuffer(commandBuffer);
+   }
+
+   const VkCommandBufferSubmitInfo commandBufferInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .pNext = nullptr,
+      .commandBuffer = commandBuffer,
+      .deviceMask = 0,
+   };
+   const VkSubmitInfo2 submitInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+      .pNext = nullptr,
+      .flags = 0,
+      .waitSemaphoreInfoCount = 0,
+      .pWaitSemaphoreInfos = nullptr,
+      .commandBufferInfoCount = 1,
+      .pCommandBufferInfos = &commandBufferInfo,
+      .signalSemaphoreInfoCount = 0,
+      .pSignalSemaphoreInfos = nullptr,
+   };
+
+   if (result == VK_SUCCESS)
+      result = vkQueueSubmit2(graphics.queues[0], 1, &submitInfo, VK_NULL_HANDLE);
+   if (result == VK_SUCCESS)
+      result = vkQueueWaitIdle(graphics.queues[0]);
+   m_reference.cpuTime = Profiler::now();
+   if (result == VK_SUCCESS)
+      result = vkGetQueryPoolResults(device, queryPool, 0, 1, sizeof(m_reference.gpuTicks), &m_reference.gpuTicks, sizeof(m_reference.gpuTicks), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+   vkDestroyCommandPool(device, commandPool, nullptr);
+   vkDestroyQueryPool(device, queryPool, nullptr);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to synchronize GPU and CPU clocks. {}", string_VkResult(result)));
+}
\ No newline at end of file
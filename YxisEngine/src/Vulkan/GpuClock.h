@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../internal_pch.h"
+
+namespace Yxis::Vulkan
+{
+   class Device;
+
+   // Maps gpu timestamps (query results) into Profiler::now()'s nanoseconds, the performance counter
+   // FrameClock reads. With VK_KHR/EXT_calibrated_timestamps and a host time domain that is that counter,
+   // both clocks are sampled together every CALIBRATION_INTERVAL and a line fitted through the last
+   // SAMPLE_COUNT samples follows their drift. Otherwise one submit and wait pins the offset and both
+   // clocks are assumed to run at the same rate. Nothing is sampled before the first capture.
+   class GpuClock
+   {
+   public:
+      static constexpr uint64_t CALIBRATION_INTERVAL = 1'000'000'000;
+      static constexpr uint32_t SAMPLE_COUNT = 16;
+      // samples the driver couldn't take closer together than this (nanoseconds) are thrown away
+      static constexpr uint64_t MAX_DEVIATION = 100'000;
+
+      GpuClock(const Device* device);
+
+      GpuClock(const GpuClock&) = delete;
+      GpuClock& operator=(const GpuClock&) = delete;
+
+      // false without timestamp support or once synchronizing failed, there's nothing to map then
+      bool isAvailable() const;
+      // true when calibrated timestamps drive the mapping
+      bool isCalibrated() const;
+      // toProfilerTime is meaningless before this
+      bool isSynchronized() const;
+
+      // while capturing: synchronizes the first time, then takes a new sample once CALIBRATION_INTERVAL passed.
+      // call it once per frame from the thread that submits to the graphics queue, the fallback submits to it
+      void update();
+      uint64_t toProfilerTime(const uint64_t gpuTicks) const;
+   private:
+      struct Sample
+      {
+         uint64_t gpuTicks;
+         uint64_t cpuTime;
+      };
+
+      const Device* m_device;
+      bool m_available = false;
+      bool m_synchronized = false;
+      // nanoseconds per tick, VkPhysicalDeviceLimits::timestampPeriod
+      double m_timestampPeriod = 1.0;
+      PFN_vkGetCalibratedTimestampsKHR m_getCalibratedTimestamps = nullptr;
+
+      std::array<Sample, SAMPLE_COUNT> m_samples{};
+      uint32_t m_sampleCount = 0;
+      uint32_t m_nextSample = 0;
+      uint64_t m_lastSampleTime = 0;
+
+      // cpu = reference.cpuTime + intercept + slope * (gpu - reference.gpuTicks) * period
+      Sample m_reference{};
+      double m_slope = 1.0;
+      double m_intercept = 0.0;
+
+      void sample();
+      void fit();
+      void synchronizeOnce();
+   };
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "GpuProfiler.h"
+#include "Device.h"
+#include <Yxis/Logger.h>
+
+using namespace Yxis::Vulkan;
+
+GpuProfiler::GpuProfiler(const Device* device)
+   : m_device(device)
+{
+   VkPhysicalDeviceVulkan12Features vulkan12Features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+   VkPhysicalDeviceFeatures2 features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &vulkan12Features };
+   vkGetPhysicalDeviceFeatures2(m_device->getPhysicalDevice(), &features);
+
+   // pools are reset from the host when they're read back, Device enables the feature when it's there
+   if (not vulkan12Features.hostQueryReset || not m_device->getGpuClock().isAvailable())
+   {
+      YX_CORE_LOGGER->info("GPU profiler disabled, no host query reset or timestamps");
+      return;
+   }
+
+   uint32_t familyCount;
+   vkGetPhysicalDeviceQueueFamilyProperties(m_device->getPhysicalDevice(), &familyCount, nullptr);
+   std::vector<VkQueueFamilyProperties> families(familyCount);
+   vkGetPhysicalDeviceQueueFamilyProperties(m_device->getPhysicalDevice(), &familyCount, families.data());
+   m_familyTracks.resize(familyCount, UINT32_MAX);
+
+   // roles can share a family, e.g. compute and transfer on one async family, they get a single track named after all of them
+   // without dedicated families everything runs on the graphics queue and lands on its track
+   std::vector<std::string> familyRoles(familyCount);
+   auto addRole = [&](const uint32_t familyIndex, const std::string_view role) {
+      std::string& roles = familyRoles[familyIndex];
+      if (not roles.empty())
+         roles += '/';
+      roles += role;
+   };
+
+   const Queues& queues = m_device->getDeviceQueues();
+   addRole(queues.graphics.familyIndex, "Graphics");
+   if (queues.compute)
+      addRole(queues.compute->familyIndex, "Compute");
+   if (queues.transfer)
+      addRole(queues.transfer->familyIndex, "Transfer");
+
+   for (uint32_t familyIndex = 0; familyIndex < familyCount; familyIndex++)
+   {
+      const std::string& roles = familyRoles[familyIndex];
+      if (roles.empty())
+         continue;
+
+      if (families[familyIndex].timestampValidBits == 0)
+      {
+         YX_CORE_LOGGER->info("{} queue family {} doesn't support timestamps, no GPU zones for it", roles, familyIndex);
+         continue;
+      }
+      m_familyTracks[familyIndex] = Profiler::createTrack("GPU", fmt::format("{} queue (family {})", roles, familyIndex));
+   }
+
+   if (m_familyTracks[queues.graphics.familyIndex] == UINT32_MAX)
+      return;
+
+   const VkQueryPoolCreateInfo createInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .queryType = VK_QUERY_TYPE_TIMESTAMP,
+      .queryCount = MAX_ZONES_PER_FRAME * 2,
+      .pipelineStatistics = 0,
+   };
+
+   for (auto& frame : m_frames)
+   {
+      VkResult result = vkCreateQueryPool(m_device->getLogicalDevice(), &createInfo, nullptr, &frame.pool);
+      if (result != VK_SUCCESS)
+         throw std::runtime_error(fmt::format("Failed to create timestamp query pool. {}", string_VkResult(result)));
+      vkResetQueryPool(m_device->getLogicalDevice(), frame.pool, 0, createInfo.queryCount);
+   }
+   m_results.resize(MAX_ZONES_PER_FRAME * 4);
+   m_enabled = true;
+}
+
+GpuProfiler::~GpuProfiler()
+{
+   for (const auto& frame : m_frames)
+   {
+      if (frame.pool != VK_NULL_HANDLE)
+         vkDestroyQueryPool(m_device->getLogicalDevice(), frame.pool, nullptr);
+   }
+}
+
+void GpuProfiler::beginFrame(const uint64_t frameNumber)
+{
+   if (not m_enabled || frameNumber == m_frameNumber)
+      return;
+
+   m_frameNumber = frameNumber;
+   GpuClock& clock = m_device->getGpuClock();
+   clock.update();
+   if (not clock.isAvailable())
+   {
+      m_enabled = false;
+      m_currentFrame = nullptr;
+      return;
+   }
+
+   FrameQueries& frame = m_frames[frameNumber % FRAME_COUNT];
+   collect(frame);
+   m_currentFrame = &frame;
+}
+
+void GpuProfiler::collect(FrameQueries& frame)
+{
+   const uint32_t requestedQueries = frame.queryCount.load(std::memory_order_acquire);
+   if (requestedQueries == 0)
+      return;
+
+   const uint32_t queryCount = std::min(requestedQueries, MAX_ZONES_PER_FRAME * 2);
+   if (requestedQueries > queryCount)
+      YX_CORE_LOGGER->warn("GPU profiler dropped {} zones, more than {} in a frame", (requestedQueries - queryCount) / 2, MAX_ZONES_PER_FRAME);
+
+   const VkDevice device = m_device->getLogicalDevice();
+   // zones recorded in the frame a capture started in can come back before the clock's first sync, they're dropped
+   const GpuClock& clock = m_device->getGpuClock();
+   if (clock.isSynchronized())
+   {
+      // no wait bit: whatever isn't available by now belongs to a zone that never ended or was never submitted
+      constexpr VkQueryResultFlags RESULT_FLAGS = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+      const VkResult result = vkGetQueryPoolResults(device, frame.pool, 0, queryCount, queryCount * 2 * sizeof(uint64_t),
+         m_results.data(), 2 * sizeof(uint64_t), RESULT_FLAGS);
+
+      if (result == VK_SUCCESS || result == VK_NOT_READY)
+      {
+         for (uint32_t query = 0; query < queryCount; query += 2)
+         {
+            const uint64_t* timestamps = &m_results[query * 2];
+            if (timestamps[1] == 0 || timestamps[3] == 0)
+            {
+               if (m_droppedZones++ == 0)
+                  YX_CORE_LOGGER->warn("GPU zone {} had no timestamps when read back, unfinished zones are dropped", frame.zones[query / 2].name);
+               continue;
+            }
+
+            const Zone& zone = frame.zones[query / 2];
+            Profiler::recordOnTrack(zone.track, zone.name, clock.toProfilerTime(timestamps[0]), clock.toProfilerTime(timestamps[2]));
+         }
+      }
+      else
+         YX_CORE_LOGGER->warn("Failed to read GPU timestamps. {}", string_VkResult(result));
+   }
+
+   vkResetQueryPool(device, frame.pool, 0, queryCount);
+   frame.queryCount.store(0, std::memory_order_relaxed);
+}
+
+uint32_t GpuProfiler::beginZone(const VkCommandBuffer commandBuffer, const uint32_t queueFamilyIndex, const char* name)
+{
+   if (m_currentFrame == nullptr || not Profiler::isCapturing()
+      || queueFamilyIndex >= m_familyTracks.size() || m_familyTracks[queueFamilyIndex] == UINT32_MAX)
+      return INVALID_ZONE;
+
+   const uint32_t query = m_currentFrame->queryCount.fetch_add(2, std::memory_order_relaxed);
+   if (query >= MAX_ZONES_PER_FRAME * 2)
+      return INVALID_ZONE;
+
+   m_currentFrame->zones[query / 2] = { name, m_familyTracks[queueFamilyIndex] };
+   vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_currentFrame->pool, query);
+   return query / 2;
+}
+
+void GpuProfiler::endZone(const VkCommandBuffer commandBuffer, const uint32_t zone)
+{
+   if (zone == INVALID_ZONE)
+      return;
+
+   vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, m_currentFrame->pool, zone * 2 + 1);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <Yxis/Profiler.h>
+
+namespace Yxis::Vulkan
+{
+   class Device;
+
+   // Timestamp queries around named zones in command buffers. Every frame gets its own query pool,
+   // the pool is read back when its slot comes around again, FRAME_COUNT frames later, so the results
+   // are long available and nothing stalls. Zones go to the CPU profiler's trace, one track per queue family,
+   // placed on its timeline by the device's GpuClock.
+   // Only records while Profiler::isCapturing().
+   class GpuProfiler
+   {
+   public:
+      static constexpr uint32_t FRAME_COUNT = 3;
+      // two timestamps per zone
+      static constexpr uint32_t MAX_ZONES_PER_FRAME = 512;
+      static constexpr uint32_t INVALID_ZONE = UINT32_MAX;
+
+      GpuProfiler(const Device* device);
+      ~GpuProfiler();
+
+      GpuProfiler(const GpuProfiler&) = delete;
+      GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+      // reads back and recycles the pool of frame frameNumber - FRAME_COUNT, which has to be retired on the gpu.
+      // calling it again for the same frame does nothing
+      void beginFrame(const uint64_t frameNumber);
+
+      // the command buffer must be submitted to a queue of queueFamilyIndex
+      uint32_t beginZone(const VkCommandBuffer commandBuffer, const uint32_t queueFamilyIndex, const char* name);
+      void endZone(const VkCommandBuffer commandBuffer, const uint32_t zone);
+   private:
+      struct Zone
+      {
+         const char* name;
+         uint32_t track;
+      };
+
+      struct FrameQueries
+      {
+         VkQueryPool pool = VK_NULL_HANDLE;
+         // two per zone, zone i owns queries 2i and 2i + 1
+         std::atomic<uint32_t> queryCount = 0;
+         std::array<Zone, MAX_ZONES_PER_FRAME> zones;
+      };
+
+      const Device* m_device;
+      bool m_enabled = false;
+      // profiler track per queue family, UINT32_MAX where timestamps aren't supported
+      std::vector<uint32_t> m_familyTracks;
+      std::array<FrameQueries, FRAME_COUNT> m_frames;
+      FrameQueries* m_currentFrame = nullptr;
+      uint64_t m_frameNumber = UINT64_MAX;
+      uint64_t m_droppedZones = 0;
+      // timestamp, availability pairs of one readback
+      std::vector<uint64_t> m_results;
+
+      void collect(FrameQueries& frame);
+   };
+
+   class GpuProfileScope
+   {
+   public:
+      GpuProfileScope(GpuProfiler& profiler, const VkCommandBuffer commandBuffer, const uint32_t queueFamilyIndex, const char* name)
+         : m_profiler(profiler), m_commandBuffer(commandBuffer), m_zone(profiler.beginZone(commandBuffer, queueFamilyIndex, name)) { }
+      ~GpuProfileScope() { m_profiler.endZone(m_commandBuffer, m_zone); }
+
+      GpuProfileScope(const GpuProfileScope&) = delete;
+      GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+   private:
+      GpuProfiler& m_profiler;
+      const VkCommandBuffer m_commandBuffer;
+      const uint32_t m_zone;
+   };
+}
+
+#ifdef YX_PROFILER
+   #define YX_GPU_PROFILE_SCOPE(profiler, commandBuffer, queueFamilyIndex, name) \
+      ::Yxis::Vulkan::GpuProfileScope YX_PROFILE_CONCAT(yxGpuProfileScope, __LINE__)(profiler, commandBuffer, queueFamilyIndex, name)
+#else
+   #define YX_GPU_PROFILE_SCOPE(profiler, commandBuffer, queueFamilyIndex, name) ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "OffscreenTarget.h"
+#include "Device.h"
+
+using namespace Yxis::Vulkan;
+
+OffscreenTarget::OffscreenTarget(const Device* device, const VkExtent2D extent, const uint32_t imageCount)
+   : m_device(device), m_extent(extent)
+{
+   m_images.resize(imageCount, VK_NULL_HANDLE);
+   m_allocations.resize(imageCount, VK_NULL_HANDLE);
+   m_imageViews.resize(imageCount, VK_NULL_HANDLE);
+
+   const VkImageCreateInfo imageCreateInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .imageType = VK_IMAGE_TYPE_2D,
+      .format = FORMAT,
+      .extent = { extent.width, extent.height, 1 },
+      .mipLevels = 1,
+      .arrayLayers = 1,
+      .samples = VK_SAMPLE_COUNT_1_BIT,
+      .tiling = VK_IMAGE_TILING_OPTIMAL,
+      .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = 0,
+      .pQueueFamilyIndices = nullptr,
+      .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+   };
+
+   const VmaAllocationCreateInfo allocationCreateInfo =
+   {
+      .flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT,
+      .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+   };
+
+   VkImageViewCreateInfo viewCreateInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .viewType = VK_IMAGE_VIEW_TYPE_2D,
+      .format = FORMAT,
+      .components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY },
+      .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+   };
+
+   for (uint32_t i = 0; i < imageCount; i++)
+   {
+      VkResult result = vmaCreateImage(m_device->getAllocator(), &imageCreateInfo, &allocationCreateInfo, &m_images[i], &m_allocations[i], nullptr);
+      if (result != VK_SUCCESS)
+         throw std::runtime_error(fmt::format("Failed to create offscreen image index {}. {}", i, string_VkResult(result)));
+
+      viewCreateInfo.image = m_images[i];
+      result = vkCreateImageView(m_device->getLogicalDevice(), &viewCreateInfo, nullptr, &m_imageViews[i]);
+      if (result != VK_SUCCESS)
+         throw std::runtime_error(fmt::format("Failed to create image view for offscreen image index {}. {}", i, string_VkResult(result)));
+   }
+}
+
+const VkFormat OffscreenTarget::getFormat() const
+{
+   return FORMAT;
+}
+
+const VkExtent2D OffscreenTarget::getExtent() const
+{
+   return m_extent;
+}
+
+const uint32_t OffscreenTarget::getImageCount() const
+{
+   return static_cast<uint32_t>(m_images.size());
+}
+
+const VkImage OffscreenTarget::getImage(const uint32_t index) const
+{
+   return m_images[index];
+}
+
+const VkImageView OffscreenTarget::getImageView(const uint32_t index) const
+{
+   return m_imageViews[index];
+}
+
+OffscreenTarget::~OffscreenTarget()
+{
+   for (const auto imageView : m_imageViews)
+   {
+      if (imageView != VK_NULL_HANDLE)
+         vkDestroyImageView(m_device->getLogicalDevice(), imageView, nullptr);
+   }
+
+   for (size_t i = 0; i < m_images.size(); i++)
+   {
+      if (m_images[i] != VK_NULL_HANDLE)
+         vmaDestroyImage(m_device->getAllocator(), m_images[i], m_allocations[i]);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include "vk_mem_alloc.h"
+
+namespace Yxis::Vulkan
+{
+   class Device;
+
+   // Color images standing in for the swapchain when there's no surface to present to
+   class OffscreenTarget
+   {
+   public:
+      OffscreenTarget(const Device* device, const VkExtent2D extent, const uint32_t imageCount);
+      ~OffscreenTarget();
+
+      OffscreenTarget(const OffscreenTarget&) = delete;
+      OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+      const VkFormat getFormat() const;
+      const VkExtent2D getExtent() const;
+      const uint32_t getImageCount() const;
+      const VkImage getImage(const uint32_t index) const;
+      const VkImageView getImageView(const uint32_t index) const;
+   private:
+      static constexpr VkFormat FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+      const Device* m_device;
+      const VkExtent2D m_extent;
+      std::vector<VkImage> m_images;
+      std::vector<VmaAllocation> m_allocations;
+      std::vector<VkImageView> m_imageViews;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "PipelineCache.h"
+#include "Device.h"
+#include "../File.h"
+#include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
+
+using namespace Yxis::Vulkan;
+
+std::vector<std::byte> PipelineCache::load(const std::string& path)
+{
+   YX_PROFILE_SCOPE("PipelineCache::load");
+   return File::readAll(path).value_or(std::vector<std::byte>{});
+}
+
+// the header is what the driver would check too, but not every driver checks it gracefully
+static bool isCompatible(const VkPhysicalDevice physicalDevice, const std::span<const std::byte> data)
+{
+   VkPipelineCacheHeaderVersionOne header;
+   if (data.size() < sizeof(header))
+      return false;
+   std::memcpy(&header, data.data(), sizeof(header));
+
+   VkPhysicalDeviceProperties properties;
+   vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+   return header.headerSize >= sizeof(header)
+      && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+      && header.vendorID == properties.vendorID
+      && header.deviceID == properties.deviceID
+      && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+PipelineCache::PipelineCache(const Device* device, const std::span<const std::byte> initialData)
+   : m_device(device)
+{
+   const bool compatible = isCompatible(m_device->getPhysicalDevice(), initialData);
+   if (not initialData.empty() && not compatible)
+      YX_CORE_LOGGER->warn("Pipeline cache was written by another device or driver, starting with an empty one");
+
+   const VkPipelineCacheCreateInfo createInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .initialDataSize = compatible ? initialData.size() : 0,
+      .pInitialData = compatible ? initialData.data() : nullptr,
+   };
+
+   VkResult result = vkCreatePipelineCache(m_device->getLogicalDevice(), &createInfo, nullptr, &m_pipelineCache);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to create pipeline cache. {}", string_VkResult(result)));
+}
+
+PipelineCache::~PipelineCache()
+{
+   vkDestroyPipelineCache(m_device->getLogicalDevice(), m_pipelineCache, nullptr);
+}
+
+PipelineCache::operator VkPipelineCache() const
+{
+   return m_pipelineCache;
+}
+
+void PipelineCache::save(const std::string& path) const
+{
+   size_t size = 0;
+   VkResult result = vkGetPipelineCacheData(m_device->getLogicalDevice(), m_pipelineCache, &size, nullptr);
+   std::vector<std::byte> data(size);
+   if (result == VK_SUCCESS)
+      result = vkGetPipelineCacheData(m_device->getLogicalDevice(), m_pipelineCache, &size, data.data());
+   if (result != VK_SUCCESS)
+   {
+      YX_CORE_LOGGER->warn("Failed to read pipeline cache data. {}", string_VkResult(result));
+      return;
+   }
+
+   std::ofstream file(path, std::ios::binary | std::ios::trunc);
+   if (not file.write(reinterpret_cast<const char*>(data.data()), size))
+      YX_CORE_LOGGER->warn("Failed to write pipeline cache to {}", path);
+}
\ No newline at end of file
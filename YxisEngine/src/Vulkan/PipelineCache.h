@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../internal_pch.h"
+
+namespace Yxis::Vulkan
+{
+   class Device;
+
+   // VkPipelineCache persisted between runs. The file is read on a job while the device is being
+   // created, data written by another driver or gpu is dropped instead of handed to the driver.
+   class PipelineCache
+   {
+   public:
+      // missing or unreadable files give an empty cache
+      static std::vector<std::byte> load(const std::string& path);
+
+      PipelineCache(const Device* device, const std::span<const std::byte> initialData);
+      ~PipelineCache();
+
+      PipelineCache(const PipelineCache&) = delete;
+      PipelineCache& operator=(const PipelineCache&) = delete;
+
+      operator VkPipelineCache() const;
+
+      void save(const std::string& path) const;
+   private:
+      const Device* m_device;
+      VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+   };
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "RenderThread.h"
+#include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
+#include <cassert>
+
+using namespace Yxis::Vulkan;
+
+RenderThread::RenderThread()
+{
+   m_thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::submitFrame(const FramePacket& frame)
+{
+   rethrowError();
+
+   // the frame before this one may still be in flight on the render thread, anything older has to be done
+   uint64_t finished = m_finished.load(std::memory_order_acquire);
+   while (m_pushed.load(std::memory_order_relaxed) - finished > MAX_FRAMES_AHEAD)
+   {
+      m_finished.wait(finished, std::memory_order_acquire);
+      finished = m_finished.load(std::memory_order_acquire);
+   }
+
+   push({ CommandType::RenderFrame, frame });
+}
+
+void RenderThread::waitIdle()
+{
+   uint64_t finished = m_finished.load(std::memory_order_acquire);
+   while (finished != m_pushed.load(std::memory_order_relaxed))
+   {
+      m_finished.wait(finished, std::memory_order_acquire);
+      finished = m_finished.load(std::memory_order_acquire);
+   }
+}
+
+void RenderThread::push(const Command& command)
+{
+   // never more than MAX_FRAMES_AHEAD + a stop in the queue
+   [[maybe_unused]] const bool pushed = m_commands.tryPush(command);
+   assert(pushed && "Render command queue overflow");
+
+   m_pushed.fetch_add(1, std::memory_order_release);
+   m_pushed.notify_one();
+}
+
+void RenderThread::rethrowError()
+{
+   if (m_failed.load(std::memory_order_acquire) && m_error)
+   {
+      // report it once, the render thread keeps draining so nothing blocks on it
+      std::exception_ptr error = std::move(m_error);
+      m_error = nullptr;
+      std::rethrow_exception(error);
+   }
+}
+
+void RenderThread::run()
+{
+   Profiler::setThreadName("Render thread");
+   uint64_t handled = 0;
+   for (;;)
+   {
+      m_pushed.wait(handled, std::memory_order_acquire);
+
+      Command command;
+      while (m_commands.tryPop(command))
+      {
+         if (command.type == CommandType::Stop)
+         {
+            m_finished.store(++handled, std::memory_order_release);
+            m_finished.notify_all();
+            return;
+         }
+
+         // after a failure frames are only retired, the main thread rethrows on its next submit
+         if (not m_failed.load(std::memory_order_relaxed))
+         {
+            try
+            {
+               VulkanRenderer::renderFrame(command.frame);
+               VulkanRenderer::endFrame();
+            }
+            catch (...)
+            {
+               m_error = std::current_exception();
+               m_failed.store(true, std::memory_order_release);
+            }
+         }
+
+         m_finished.store(++handled, std::memory_order_release);
+         m_finished.notify_all();
+      }
+   }
+}
+
+RenderThread::~RenderThread()
+{
+   push({ CommandType::Stop, {} });
+   m_thread.join();
+
+   if (m_error)
+   {
+      try
+      {
+         std::rethrow_exception(m_error);
+      }
+      catch (const std::exception& e)
+      {
+         YX_CORE_LOGGER->error("Render thread failed: {}", e.what());
+      }
+   }
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include "SpscQueue.h"
+#include "VulkanRenderer.h"
+
+namespace Yxis::Vulkan
+{
+   // Owns the thread that submits and presents frames. The main thread hands frames over through
+   // a lock-free queue and may run at most one frame ahead of the frame being submitted.
+   class RenderThread
+   {
+   public:
+      RenderThread();
+      // finishes the frames already handed over, then joins
+      ~RenderThread();
+
+      RenderThread(const RenderThread&) = delete;
+      RenderThread& operator=(const RenderThread&) = delete;
+
+      // blocks while the previous frame hasn't been picked up yet
+      // rethrows the error if the render thread failed
+      void submitFrame(const FramePacket& frame);
+      // blocks until every handed over frame is submitted
+      void waitIdle();
+   private:
+      enum class CommandType : uint8_t
+      {
+         RenderFrame,
+         Stop
+      };
+
+      struct Command
+      {
+         CommandType type = CommandType::Stop;
+         FramePacket frame{};
+      };
+
+      void run();
+      void push(const Command& command);
+      void rethrowError();
+
+      static constexpr size_t QUEUE_CAPACITY = 4;
+      static constexpr uint64_t MAX_FRAMES_AHEAD = 1;
+
+      SpscQueue<Command, QUEUE_CAPACITY> m_commands;
+      // commands pushed by the main thread / finished by the render thread, both only grow
+      std::atomic<uint64_t> m_pushed = 0;
+      std::atomic<uint64_t> m_finished = 0;
+
+      std::exception_ptr m_error;
+      std::atomic<bool> m_failed = false;
+      std::thread m_thread;
+   };
+}
\ No newline at end of file
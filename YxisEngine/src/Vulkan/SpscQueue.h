@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <bit>
+
+namespace Yxis::Vulkan
+{
+   // Bounded lock-free single-producer single-consumer queue.
+   // Each side keeps a cached copy of the other side's index, so the shared indices are
+   // only read when the cached one says the queue looks full/empty.
+   template <typename T, size_t Capacity>
+   class SpscQueue
+   {
+      static_assert(std::has_single_bit(Capacity), "Capacity has to be a power of two");
+   public:
+      SpscQueue() = default;
+      SpscQueue(const SpscQueue&) = delete;
+      SpscQueue& operator=(const SpscQueue&) = delete;
+
+      // producer only, returns false if the queue is full
+      bool tryPush(const T& value)
+      {
+         const size_t tail = m_tail.load(std::memory_order_relaxed);
+         if (tail - m_cachedHead == Capacity)
+         {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity)
+               return false;
+         }
+
+         m_slots[tail & (Capacity - 1)] = value;
+         m_tail.store(tail + 1, std::memory_order_release);
+         return true;
+      }
+
+      // consumer only, returns false if the queue is empty
+      bool tryPop(T& value)
+      {
+         const size_t head = m_head.load(std::memory_order_relaxed);
+         if (head == m_cachedTail)
+         {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+               return false;
+         }
+
+         value = m_slots[head & (Capacity - 1)];
+         m_head.store(head + 1, std::memory_order_release);
+         return true;
+      }
+   private:
+      std::array<T, Capacity> m_slots{};
+      // consumer side
+      alignas(64) std::atomic<size_t> m_head = 0;
+      size_t m_cachedTail = 0;
+      // producer side
+      alignas(64) std::atomic<size_t> m_tail = 0;
+      size_t m_cachedHead = 0;
+   };
+}
\ No newline at end of file
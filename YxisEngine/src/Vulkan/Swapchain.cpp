@@ -1,40 +1,62 @@
 #include "Swapchain.h"
 #include "Device.h"
 #include "../Window.h"
+#include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
 
 using namespace Yxis::Vulkan;
 
 Swapchain::Swapchain(const Device* device)
    : m_device(device)
 {
-   const auto surfaceCapabilites = device->getSurfaceCapabilities().surfaceCapabilities;
-   
-   VkSurfaceFormatKHR surfaceFormat{ VK_FORMAT_UNDEFINED };
+   YX_PROFILE_SCOPE("Swapchain::Swapchain");
    {
       const auto surfaceFormats = device->getSurfaceFormats();
       for (const auto& [sType, pNext, availableFormat] : surfaceFormats)
       {
          if (availableFormat.format == VK_FORMAT_R8G8B8A8_SRGB && availableFormat.colorSpace == VK_COLORSPACE_SRGB_NONLINEAR_KHR)
          {
-            surfaceFormat = availableFormat;
+            m_surfaceFormat = availableFormat;
             break;
          }
       }
 
-      if (surfaceFormat.format == VK_FORMAT_UNDEFINED)
-         surfaceFormat = surfaceFormats[0].surfaceFormat;
+      if (m_surfaceFormat.format == VK_FORMAT_UNDEFINED)
+         m_surfaceFormat = surfaceFormats[0].surfaceFormat;
    }
 
-   VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR; // fifo is always available
+   // fifo is always available
    {
       const auto presentModes = device->getPresentModes();
       for (const auto availablePresentMode : presentModes)
       {
          if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-            presentMode = availablePresentMode;
+            m_presentMode = availablePresentMode;
       }
    }
 
+   create(VK_NULL_HANDLE, Window::getExtent());
+   YX_CORE_LOGGER->info("Swapchain created: {}x{}, {} images, {}, {}", m_extent.width, m_extent.height, m_swapchainImages.size(),
+      string_VkFormat(m_surfaceFormat.format), string_VkPresentModeKHR(m_presentMode));
+}
+
+void Swapchain::create(const VkSwapchainKHR oldSwapchain, const VkExtent2D extent)
+{
+   const auto surfaceCapabilites = m_device->getSurfaceCapabilities().surfaceCapabilities;
+
+   // 0xFFFFFFFF means the swapchain decides the size (headless surfaces, some wayland compositors)
+   m_extent = surfaceCapabilites.currentExtent;
+   if (m_extent.width == UINT32_MAX)
+   {
+      m_extent.width = std::clamp(extent.width, surfaceCapabilites.minImageExtent.width, surfaceCapabilites.maxImageExtent.width);
+      m_extent.height = std::clamp(extent.height, surfaceCapabilites.minImageExtent.height, surfaceCapabilites.maxImageExtent.height);
+   }
+
+   // one over the minimum so acquire doesn't wait on the presentation engine
+   uint32_t imageCount = surfaceCapabilites.minImageCount + 1;
+   if (surfaceCapabilites.maxImageCount != 0)
+      imageCount = std::min(imageCount, surfaceCapabilites.maxImageCount);
+
    {
       const auto gfxQueueIndex = m_device->getDeviceQueues().graphics.familyIndex;
       VkSwapchainCreateInfoKHR createInfo =
@@ -43,19 +65,20 @@ Swapchain::Swapchain(const Device* device)
          .pNext = nullptr,
          .flags = 0,
          .surface = Window::getSurface(),
-         .minImageCount = surfaceCapabilites.minImageCount,
-         .imageFormat = surfaceFormat.format,
-         .imageColorSpace = surfaceFormat.colorSpace,
-         .imageExtent = surfaceCapabilites.currentExtent,
+         .minImageCount = imageCount,
+         .imageFormat = m_surfaceFormat.format,
+         .imageColorSpace = m_surfaceFormat.colorSpace,
+         .imageExtent = m_extent,
          .imageArrayLayers = 1,
-         .imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+         .imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (surfaceCapabilites.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT),
          .imageSharingMode = VK_SHARING_MODE_EXCLUSIVE,
          .queueFamilyIndexCount = 1,
          .pQueueFamilyIndices = &gfxQueueIndex,
          .preTransform = surfaceCapabilites.currentTransform,
          .compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+         .presentMode = m_presentMode,
          .clipped = VK_FALSE,
-         .oldSwapchain = nullptr
+         .oldSwapchain = oldSwapchain
       };
 
       VkResult result = vkCreateSwapchainKHR(m_device->getLogicalDevice(), &createInfo, nullptr, &m_swapchain);
@@ -63,11 +86,11 @@ Swapchain::Swapchain(const Device* device)
          throw std::runtime_error(fmt::format("Failed to create swapchain. {}", string_VkResult(result)));
    }
 
-   uint32_t imageCount;
-   vkGetSwapchainImagesKHR(m_device->getLogicalDevice(), m_swapchain, &imageCount, nullptr);
-   m_swapchainImages.resize(imageCount);
-   m_swapchainImageViews.resize(imageCount);
-   vkGetSwapchainImagesKHR(m_device->getLogicalDevice(), m_swapchain, &imageCount, m_swapchainImages.data());
+   uint32_t swapchainImageCount;
+   vkGetSwapchainImagesKHR(m_device->getLogicalDevice(), m_swapchain, &swapchainImageCount, nullptr);
+   m_swapchainImages.resize(swapchainImageCount);
+   m_swapchainImageViews.resize(swapchainImageCount);
+   vkGetSwapchainImagesKHR(m_device->getLogicalDevice(), m_swapchain, &swapchainImageCount, m_swapchainImages.data());
 
    VkImageViewCreateInfo createInfo =
    {
@@ -75,12 +98,12 @@ Swapchain::Swapchain(const Device* device)
       .pNext = nullptr,
       .flags = 0,
       .viewType = VK_IMAGE_VIEW_TYPE_2D,
-      .format = surfaceFormat.format,
+      .format = m_surfaceFormat.format,
       .components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY },
       .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
    };
 
-   for (uint32_t i = 0; i < imageCount; i++)
+   for (uint32_t i = 0; i < swapchainImageCount; i++)
    {
       createInfo.image = m_swapchainImages[i];
       VkResult result = vkCreateImageView(m_device->getLogicalDevice(), &createInfo, nullptr, &m_swapchainImageViews[i]);
@@ -89,10 +112,90 @@ Swapchain::Swapchain(const Device* device)
    }
 }
 
-Swapchain::~Swapchain()
+void Swapchain::recreate(const VkExtent2D extent)
+{
+   YX_PROFILE_SCOPE("Swapchain::recreate");
+   destroyImageViews();
+   const VkSwapchainKHR oldSwapchain = m_swapchain;
+   create(oldSwapchain, extent);
+   vkDestroySwapchainKHR(m_device->getLogicalDevice(), oldSwapchain, nullptr);
+}
+
+bool Swapchain::acquireNextImage(const VkSemaphore signalSemaphore, uint32_t& imageIndex)
+{
+   VkResult result = vkAcquireNextImageKHR(m_device->getLogicalDevice(), m_swapchain, UINT64_MAX, signalSemaphore, VK_NULL_HANDLE, &imageIndex);
+   if (result == VK_ERROR_OUT_OF_DATE_KHR)
+      return false;
+   // suboptimal still signals the semaphore, the image is used and the swapchain recreated after presenting
+   if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+      throw std::runtime_error(fmt::format("Failed to acquire swapchain image. {}", string_VkResult(result)));
+
+   return true;
+}
+
+bool Swapchain::present(const VkQueue queue, const uint32_t imageIndex, const VkSemaphore waitSemaphore)
+{
+   const VkPresentInfoKHR presentInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+      .pNext = nullptr,
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores = &waitSemaphore,
+      .swapchainCount = 1,
+      .pSwapchains = &m_swapchain,
+      .pImageIndices = &imageIndex,
+      .pResults = nullptr,
+   };
+
+   VkResult result = vkQueuePresentKHR(queue, &presentInfo);
+   if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+      return false;
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to present swapchain image. {}", string_VkResult(result)));
+
+   return true;
+}
+
+const VkFormat Swapchain::getFormat() const
+{
+   return m_surfaceFormat.format;
+}
+
+const VkExtent2D Swapchain::getExtent() const
+{
+   return m_extent;
+}
+
+const VkPresentModeKHR Swapchain::getPresentMode() const
+{
+   return m_presentMode;
+}
+
+const uint32_t Swapchain::getImageCount() const
+{
+   return static_cast<uint32_t>(m_swapchainImages.size());
+}
+
+const VkImage Swapchain::getImage(const uint32_t index) const
+{
+   return m_swapchainImages[index];
+}
+
+const VkImageView Swapchain::getImageView(const uint32_t index) const
+{
+   return m_swapchainImageViews[index];
+}
+
+void Swapchain::destroyImageViews()
 {
    for (const auto imageView : m_swapchainImageViews)
       vkDestroyImageView(m_device->getLogicalDevice(), imageView, nullptr);
+   m_swapchainImageViews.clear();
+}
+
+Swapchain::~Swapchain()
+{
+   destroyImageViews();
 
    if (m_swapchain != VK_NULL_HANDLE)
       vkDestroySwapchainKHR(m_device->getLogicalDevice(), m_swapchain, nullptr);
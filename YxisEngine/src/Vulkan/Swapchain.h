@@ -9,9 +9,33 @@ namespace Yxis::Vulkan
    public:
       Swapchain(const Device* device);
       ~Swapchain();
+
+      Swapchain(const Swapchain&) = delete;
+      Swapchain& operator=(const Swapchain&) = delete;
+
+      // rebuilds the swapchain, the old images must not be in use anymore
+      // extent is only used when the surface leaves the size up to the swapchain
+      void recreate(const VkExtent2D extent);
+
+      // both return false when the swapchain is out of date and has to be recreated
+      bool acquireNextImage(const VkSemaphore signalSemaphore, uint32_t& imageIndex);
+      bool present(const VkQueue queue, const uint32_t imageIndex, const VkSemaphore waitSemaphore);
+
+      const VkFormat getFormat() const;
+      const VkExtent2D getExtent() const;
+      const VkPresentModeKHR getPresentMode() const;
+      const uint32_t getImageCount() const;
+      const VkImage getImage(const uint32_t index) const;
+      const VkImageView getImageView(const uint32_t index) const;
    private:
+      void create(const VkSwapchainKHR oldSwapchain, const VkExtent2D extent);
+      void destroyImageViews();
+
       const Device* m_device;
       VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
+      VkSurfaceFormatKHR m_surfaceFormat{ VK_FORMAT_UNDEFINED };
+      VkPresentModeKHR m_presentMode = VK_PRESENT_MODE_FIFO_KHR;
+      VkExtent2D m_extent{};
       std::vector<VkImage> m_swapchainImages;
       std::vector<VkImageView> m_swapchainImageViews;
    };
@@ -27,6 +27,11 @@ TimelineSemaphore::TimelineSemaphore(const Device* device, const uint64_t initia
       throw std::runtime_error(fmt::format("Failed to create semaphore. {}", string_VkResult(result)));
 }
 
+TimelineSemaphore::operator VkSemaphore() const
+{
+   return m_semaphore;
+}
+
 void TimelineSemaphore::wait(const uint64_t waitValue, const uint64_t timeout)
 {
    const VkSemaphoreWaitInfo waitInfo =
@@ -48,6 +53,11 @@ void TimelineSemaphore::wait(const uint64_t waitValue, const uint64_t timeout)
       throw std::runtime_error(fmt::format("Failed to wait for a semaphore. {}", string_VkResult(result)));
 }
 
+TimelineAwaiter TimelineSemaphore::waitAsync(const uint64_t waitValue) const
+{
+   return TimelineAwaiter{ m_device->getTimelineWaiter(), m_semaphore, waitValue };
+}
+
 void TimelineSemaphore::signal(const uint64_t value)
 {
    const VkSemaphoreSignalInfo signalInfo =
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../internal_pch.h"
+#include "TimelineWaiter.h"
 
 namespace Yxis::Vulkan
 {
@@ -13,7 +14,11 @@ namespace Yxis::Vulkan
       TimelineSemaphore(const Device* device, const uint64_t initialValue = 0);
       ~TimelineSemaphore();
 
+      operator VkSemaphore() const;
+
       void wait(const uint64_t waitValue, const uint64_t timeout = UINT64_MAX);
+      // co_await from a Tasks::Task, the coroutine continues on a job system worker once waitValue is reached
+      TimelineAwaiter waitAsync(const uint64_t waitValue) const;
       void signal(const uint64_t value);
    private:
       VkSemaphore m_semaphore;
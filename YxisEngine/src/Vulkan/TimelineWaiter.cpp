@@ -0,0 +1,108 @@
+#include "TimelineWaiter.h"
+#include "TimelineSemaphore.h"
+#include "Device.h"
+#include <Yxis/JobSystem.h>
+#include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
+
+using namespace Yxis::Vulkan;
+
+TimelineWaiter::TimelineWaiter(const Device* device)
+   : m_device(device), m_wakeup(std::make_unique<TimelineSemaphore>(device, 0))
+{
+   m_thread = std::thread(&TimelineWaiter::run, this);
+}
+
+bool TimelineWaiter::isReached(const VkSemaphore semaphore, const uint64_t value) const
+{
+   uint64_t current = 0;
+   VkResult result = vkGetSemaphoreCounterValue(*m_device, semaphore, &current);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to read semaphore value. {}", string_VkResult(result)));
+
+   return current >= value;
+}
+
+void TimelineWaiter::enqueue(const VkSemaphore semaphore, const uint64_t value, const std::coroutine_handle<> handle)
+{
+   std::lock_guard lock(m_mutex);
+   m_newWaits.push_back({ semaphore, value, handle });
+   m_wakeup->signal(++m_wakeupValue);
+}
+
+void TimelineWaiter::run()
+{
+   Profiler::setThreadName("Timeline waiter");
+   std::vector<Wait> waits;
+   std::vector<VkSemaphore> semaphores;
+   std::vector<uint64_t> values;
+   uint64_t wakeupSeen = 0;
+
+   for (;;)
+   {
+      {
+         std::lock_guard lock(m_mutex);
+         if (m_stopping)
+            break;
+
+         waits.insert(waits.end(), m_newWaits.begin(), m_newWaits.end());
+         m_newWaits.clear();
+      }
+
+      // the wakeup semaphore goes first, any enqueue after this point bumps it past wakeupSeen
+      semaphores.assign(1, *m_wakeup);
+      values.assign(1, wakeupSeen + 1);
+      for (const Wait& wait : waits)
+      {
+         semaphores.push_back(wait.semaphore);
+         values.push_back(wait.value);
+      }
+
+      const VkSemaphoreWaitInfo waitInfo =
+      {
+         .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+         .pNext = nullptr,
+         .flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+         .semaphoreCount = static_cast<uint32_t>(semaphores.size()),
+         .pSemaphores = semaphores.data(),
+         .pValues = values.data(),
+      };
+
+      VkResult result = vkWaitSemaphores(*m_device, &waitInfo, UINT64_MAX);
+      if (result != VK_SUCCESS && result != VK_TIMEOUT)
+      {
+         YX_CORE_LOGGER->critical("Timeline waiter stopped, {} coroutines will never resume. {}", waits.size(), string_VkResult(result));
+         return;
+      }
+
+      vkGetSemaphoreCounterValue(*m_device, *m_wakeup, &wakeupSeen);
+
+      for (size_t i = 0; i < waits.size();)
+      {
+         uint64_t current = 0;
+         if (vkGetSemaphoreCounterValue(*m_device, waits[i].semaphore, &current) != VK_SUCCESS || current < waits[i].value)
+         {
+            i++;
+            continue;
+         }
+
+         const std::coroutine_handle<> handle = waits[i].handle;
+         JobSystem::run([handle]() { handle.resume(); });
+         waits[i] = waits.back();
+         waits.pop_back();
+      }
+   }
+
+   if (not waits.empty())
+      YX_CORE_LOGGER->warn("Timeline waiter shut down with {} coroutines still waiting", waits.size());
+}
+
+TimelineWaiter::~TimelineWaiter()
+{
+   {
+      std::lock_guard lock(m_mutex);
+      m_stopping = true;
+      m_wakeup->signal(++m_wakeupValue);
+   }
+   m_thread.join();
+}
\ No newline at end of file
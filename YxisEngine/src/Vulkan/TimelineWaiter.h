@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../internal_pch.h"
+#include <coroutine>
+
+namespace Yxis::Vulkan
+{
+   class Device;
+   class TimelineSemaphore;
+
+   // One thread that waits on every pending (timeline semaphore, value) pair at once with
+   // vkWaitSemaphores(WAIT_ANY) and resumes the coroutines whose value was reached on the job system.
+   // New waits interrupt the wait by signaling a private wakeup semaphore that's part of the set.
+   class TimelineWaiter
+   {
+   public:
+      TimelineWaiter(const Device* device);
+      ~TimelineWaiter();
+
+      TimelineWaiter(const TimelineWaiter&) = delete;
+      TimelineWaiter& operator=(const TimelineWaiter&) = delete;
+
+      bool isReached(const VkSemaphore semaphore, const uint64_t value) const;
+      // handle is resumed on a job system worker once semaphore reaches value
+      void enqueue(const VkSemaphore semaphore, const uint64_t value, const std::coroutine_handle<> handle);
+   private:
+      struct Wait
+      {
+         VkSemaphore semaphore;
+         uint64_t value;
+         std::coroutine_handle<> handle;
+      };
+
+      void run();
+
+      const Device* m_device;
+      std::unique_ptr<TimelineSemaphore> m_wakeup;
+
+      std::mutex m_mutex;
+      std::vector<Wait> m_newWaits;
+      uint64_t m_wakeupValue = 0;
+      bool m_stopping = false;
+      std::thread m_thread;
+   };
+
+   // co_await semaphore.waitAsync(value)
+   struct TimelineAwaiter
+   {
+      TimelineWaiter& waiter;
+      VkSemaphore semaphore;
+      uint64_t value;
+
+      bool await_ready() const { return waiter.isReached(semaphore, value); }
+      void await_suspend(const std::coroutine_handle<> handle) const { waiter.enqueue(semaphore, value, handle); }
+      void await_resume() const noexcept {}
+   };
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "ValidationMessageFilter.h"
+#include <Yxis/Logger.h>
+
+using namespace Yxis::Vulkan;
+
+static constexpr size_t MAX_TRACKED_MESSAGES = 4096;
+
+ValidationMessageFilter::ValidationMessageFilter(const Settings& settings)
+   : m_settings(settings)
+{
+}
+
+bool ValidationMessageFilter::submit(VkDebugUtilsMessageTypeFlagsEXT messageTypes, const VkDebugUtilsMessengerCallbackDataEXT* callbackData)
+{
+   const int32_t id = callbackData->messageIdNumber;
+   const std::string_view message = callbackData->pMessage ? callbackData->pMessage : "";
+   const auto now = Clock::now();
+
+   std::lock_guard lock(m_mutex);
+   MessageStats& stats = m_stats[id];
+   if (stats.total++ == 0 && callbackData->pMessageIdName)
+      stats.name = callbackData->pMessageIdName;
+
+   if (messageTypes & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+   {
+      PerformanceWarning& warning = m_framePerformanceWarnings[id];
+      if (warning.count++ == 0)
+      {
+         warning.name = stats.name;
+         warning.firstMessage = message;
+      }
+      return false;
+   }
+
+   // the same text within the dedupe window
+   // (messages embedding handles are mostly unique, so expired entries get pruned once in a while)
+   if (m_lastSeen.size() >= MAX_TRACKED_MESSAGES)
+      std::erase_if(m_lastSeen, [&](const auto& entry) { return now - entry.second >= m_settings.dedupeWindow; });
+
+   const size_t hash = std::hash<std::string_view>{}(message) ^ (static_cast<size_t>(static_cast<uint32_t>(id)) << 1);
+   auto [lastSeen, firstTime] = m_lastSeen.try_emplace(hash, now);
+   if (not firstTime)
+   {
+      if (now - lastSeen->second < m_settings.dedupeWindow)
+      {
+         stats.suppressed++;
+         return false;
+      }
+      lastSeen->second = now;
+   }
+
+   // per id rate limit
+   if (now - stats.rateWindowStart >= m_settings.rateWindow)
+   {
+      if (stats.rateWindowCount > m_settings.maxMessagesPerWindow)
+         YX_CORE_WARN("Validation message {} was rate limited {} times", stats.name, stats.rateWindowCount - m_settings.maxMessagesPerWindow);
+
+      stats.rateWindowStart = now;
+      stats.rateWindowCount = 0;
+   }
+
+   if (++stats.rateWindowCount > m_settings.maxMessagesPerWindow)
+   {
+      stats.suppressed++;
+      return false;
+   }
+
+   return true;
+}
+
+void ValidationMessageFilter::endFrame()
+{
+   std::lock_guard lock(m_mutex);
+   if (m_framePerformanceWarnings.empty() && m_lastFramePerformanceWarnings.empty())
+      return;
+
+   std::swap(m_framePerformanceWarnings, m_lastFramePerformanceWarnings);
+   m_framePerformanceWarnings.clear();
+}
+
+void ValidationMessageFilter::dumpPerformanceSummary() const
+{
+   std::lock_guard lock(m_mutex);
+   if (m_lastFramePerformanceWarnings.empty())
+   {
+      YX_CORE_INFO("No Vulkan performance warnings in the last frame");
+      return;
+   }
+
+   YX_CORE_WARN("Vulkan performance warnings in the last frame:");
+   for (const auto& [id, warning] : m_lastFramePerformanceWarnings)
+      YX_CORE_WARN("  {}x {} ({:#x}): {}", warning.count, warning.name, static_cast<uint32_t>(id), warning.firstMessage);
+}
+
+void ValidationMessageFilter::dumpStatistics() const
+{
+   std::lock_guard lock(m_mutex);
+   for (const auto& [id, stats] : m_stats)
+   {
+      if (stats.suppressed > 0)
+         YX_CORE_INFO("Validation message {} ({:#x}): {} received, {} suppressed", stats.name, static_cast<uint32_t>(id), stats.total, stats.suppressed);
+   }
+}
\ No newline at end of file
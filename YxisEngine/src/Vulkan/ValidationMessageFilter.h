@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../internal_pch.h"
+
+namespace Yxis::Vulkan
+{
+   // Sits between the debug messenger and the logger. Repeated messages are deduplicated,
+   // every message id is rate limited and performance warnings are only collected into a
+   // per-frame summary. Callbacks may come from any thread.
+   class ValidationMessageFilter
+   {
+   public:
+      using Clock = std::chrono::steady_clock;
+
+      struct Settings
+      {
+         Clock::duration dedupeWindow = std::chrono::seconds(5); // identical messages are shown once per window
+         Clock::duration rateWindow = std::chrono::seconds(1);
+         uint32_t maxMessagesPerWindow = 5;                      // per message id
+      };
+
+      ValidationMessageFilter() = default;
+      ValidationMessageFilter(const Settings& settings);
+
+      // returns true if the message should be logged
+      bool submit(VkDebugUtilsMessageTypeFlagsEXT messageTypes, const VkDebugUtilsMessengerCallbackDataEXT* callbackData);
+
+      // closes the current frame's performance warning summary
+      void endFrame();
+      void dumpPerformanceSummary() const;
+      void dumpStatistics() const;
+   private:
+      struct MessageStats
+      {
+         std::string name;
+         uint64_t total = 0;
+         uint64_t suppressed = 0;
+         Clock::time_point rateWindowStart;
+         uint32_t rateWindowCount = 0;
+      };
+
+      struct PerformanceWarning
+      {
+         std::string name;
+         std::string firstMessage;
+         uint32_t count = 0;
+      };
+
+      Settings m_settings;
+      mutable std::mutex m_mutex;
+      std::unordered_map<int32_t, MessageStats> m_stats;
+      std::unordered_map<size_t, Clock::time_point> m_lastSeen; // message hash -> last time it was logged
+      std::unordered_map<int32_t, PerformanceWarning> m_framePerformanceWarnings;
+      std::unordered_map<int32_t, PerformanceWarning> m_lastFramePerformanceWarnings;
+   };
+}
\ No newline at end of file
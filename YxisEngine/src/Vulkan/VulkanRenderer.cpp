@@ -1,11 +1,27 @@
 #include "VulkanRenderer.h"
+#include "ValidationMessageFilter.h"
 #include "../Window.h"
 #include <Yxis/Logger.h>
+#include <Yxis/Profiler.h>
 
 using namespace Yxis::Vulkan;
 
 constexpr uint32_t ENGINE_VERSION = VK_MAKE_VERSION(1, 0, 0);
 
+// whatever SDL may ask for later, the window doesn't exist yet when the instance is created
+static constexpr std::array SURFACE_EXTENSIONS =
+{
+   "VK_KHR_surface",
+   "VK_KHR_win32_surface",
+   "VK_KHR_xlib_surface",
+   "VK_KHR_xcb_surface",
+   "VK_KHR_wayland_surface",
+   "VK_KHR_android_surface",
+   "VK_EXT_metal_surface",
+   "VK_EXT_headless_surface",
+   "VK_KHR_get_surface_capabilities2",
+};
+
 // class fields
 std::string VulkanRenderer::m_appName;
 VkInstance VulkanRenderer::m_instance = VK_NULL_HANDLE;
@@ -13,6 +29,20 @@ VkInstance VulkanRenderer::m_instance = VK_NULL_HANDLE;
 VkDebugUtilsMessengerEXT VulkanRenderer::m_debugMessenger = VK_NULL_HANDLE;
 #endif
 std::unique_ptr<Device> VulkanRenderer::m_device;
+VkCommandPool VulkanRenderer::m_commandPool = VK_NULL_HANDLE;
+std::array<VkCommandBuffer, VulkanRenderer::FRAMES_IN_FLIGHT> VulkanRenderer::m_commandBuffers{};
+std::unique_ptr<TimelineSemaphore> VulkanRenderer::m_frameTimeline;
+uint64_t VulkanRenderer::m_frameNumber = 0;
+std::array<VkSemaphore, VulkanRenderer::FRAMES_IN_FLIGHT> VulkanRenderer::m_acquireSemaphores{};
+std::vector<VkSemaphore> VulkanRenderer::m_presentSemaphores;
+std::vector<const char*> VulkanRenderer::m_instanceExtensions;
+VkPhysicalDevice VulkanRenderer::m_physicalDevice = VK_NULL_HANDLE;
+std::unique_ptr<PipelineCache> VulkanRenderer::m_pipelineCache;
+std::string VulkanRenderer::m_pipelineCachePath;
+
+#ifdef YX_DEBUG
+static ValidationMessageFilter s_validationFilter;
+#endif
 
 static VkBool32 DebugMessengerCallback(
    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
@@ -20,23 +50,44 @@ static VkBool32 DebugMessengerCallback(
    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
    void* pUserData)
 {
+   auto* filter = static_cast<ValidationMessageFilter*>(pUserData);
+   if (filter && not filter->submit(messageTypes, pCallbackData))
+      return VK_FALSE;
+
    switch (messageSeverity)
    {
    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-      YX_CORE_LOGGER->info(pCallbackData->pMessage);
+      YX_CORE_INFO(pCallbackData->pMessage);
       break;
    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-      YX_CORE_LOGGER->info(pCallbackData->pMessage);
+      YX_CORE_INFO(pCallbackData->pMessage);
       break;
    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-      YX_CORE_LOGGER->error(pCallbackData->pMessage);
+      YX_CORE_ERROR(pCallbackData->pMessage);
       break;
    }
 
    return VK_FALSE;
 }
 
+static VkSemaphore createBinarySemaphore(const VkDevice device)
+{
+   const VkSemaphoreCreateInfo createInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+   };
+
+   VkSemaphore semaphore;
+   VkResult result = vkCreateSemaphore(device, &createInfo, nullptr, &semaphore);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to create semaphore. {}", string_VkResult(result)));
+
+   return semaphore;
+}
+
 constexpr VkDebugUtilsMessageSeverityFlagsEXT MESSAGE_SEVERITIES = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | 
 VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | 
 VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | 
@@ -54,25 +105,57 @@ static constexpr VkDebugUtilsMessengerCreateInfoEXT DEBUG_MESSENGER_CREATE_INFO
    .messageSeverity = MESSAGE_SEVERITIES,
    .messageType = MESSAGE_TYPES,
    .pfnUserCallback = DebugMessengerCallback,
+#ifdef YX_DEBUG
+   .pUserData = &s_validationFilter,
+#else
    .pUserData = nullptr,
+#endif
 };
 
-void VulkanRenderer::initialize(const std::string& appName)
+void VulkanRenderer::createInstance(const std::string& appName, const bool headless)
 {
+   YX_PROFILE_SCOPE("VulkanRenderer::createInstance");
    m_appName = appName;
    volkInitialize();
    VkResult result;
 
    {
-      auto instanceExtensions = Window::getRequiredInstanceExtensions();
+      std::vector<const char*> instanceExtensions;
+      if (not headless)
+      {
+         uint32_t extensionsCount;
+         vkEnumerateInstanceExtensionProperties(nullptr, &extensionsCount, nullptr);
+         std::vector<VkExtensionProperties> availableExtensions(extensionsCount);
+         vkEnumerateInstanceExtensionProperties(nullptr, &extensionsCount, availableExtensions.data());
+         for (const char* extension : SURFACE_EXTENSIONS)
+         {
+            if (std::any_of(availableExtensions.begin(), availableExtensions.end(), [extension](const VkExtensionProperties& available) {
+               return std::strcmp(available.extensionName, extension) == 0;
+               }))
+               instanceExtensions.emplace_back(extension);
+         }
+      }
+      std::vector<const char*> instanceEnabledLayers;
 #ifdef YX_DEBUG
       instanceExtensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-      instanceExtensions.emplace_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
-      constexpr std::array<const char*, 1> INSTANCE_ENABLED_LAYERS = { "VK_LAYER_KHRONOS_validation" };
-#else
-      constexpr std::array<const char*, 0> INSTANCE_ENABLED_LAYERS = {};
+
+      // build and benchmark machines often don't have the sdk installed
+      uint32_t layersCount;
+      vkEnumerateInstanceLayerProperties(&layersCount, nullptr);
+      std::vector<VkLayerProperties> availableLayers(layersCount);
+      vkEnumerateInstanceLayerProperties(&layersCount, availableLayers.data());
+      const bool validationAvailable = std::any_of(availableLayers.begin(), availableLayers.end(), [](const VkLayerProperties& layer) {
+         return std::strcmp(layer.layerName, "VK_LAYER_KHRONOS_validation") == 0;
+         });
+
+      if (validationAvailable)
+      {
+         instanceExtensions.emplace_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+         instanceEnabledLayers.emplace_back("VK_LAYER_KHRONOS_validation");
+      }
+      else
+         YX_CORE_LOGGER->warn("VK_LAYER_KHRONOS_validation is not available, running without validation");
 #endif
-      instanceExtensions.emplace_back("VK_KHR_get_surface_capabilities2");
 
       const VkApplicationInfo appInfo =
       {
@@ -95,8 +178,8 @@ void VulkanRenderer::initialize(const std::string& appName)
 #endif
          .flags = 0,
          .pApplicationInfo = &appInfo,
-         .enabledLayerCount = static_cast<uint32_t>(INSTANCE_ENABLED_LAYERS.size()),
-         .ppEnabledLayerNames = INSTANCE_ENABLED_LAYERS.data(),
+         .enabledLayerCount = static_cast<uint32_t>(instanceEnabledLayers.size()),
+         .ppEnabledLayerNames = instanceEnabledLayers.data(),
          .enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size()),
          .ppEnabledExtensionNames = instanceExtensions.data(),
       };
@@ -116,14 +199,16 @@ void VulkanRenderer::initialize(const std::string& appName)
          throw std::runtime_error(fmt::format("Couldn't create Vulkan debug messenger. {}", string_VkResult(result)));
       }
 #endif
-   }
 
-   Window::createSurface(m_instance);
+      m_instanceExtensions = instanceExtensions;
+   }
 
-   VkPhysicalDevice selectedDevice = VK_NULL_HANDLE;
+   m_physicalDevice = VK_NULL_HANDLE;
    {
       uint32_t devicesCount;
       vkEnumeratePhysicalDevices(m_instance, &devicesCount, nullptr);
+      if (devicesCount == 0)
+         throw std::runtime_error("No Vulkan devices found");
       std::vector<VkPhysicalDevice> physicalDevices(devicesCount);
       vkEnumeratePhysicalDevices(m_instance, &devicesCount, physicalDevices.data());
 
@@ -138,14 +223,249 @@ void VulkanRenderer::initialize(const std::string& appName)
 
          // discrete gpu is likely the most powerful, i leave it like this just for now
          if (properties.properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
-            selectedDevice = physicalDevice;
+            m_physicalDevice = physicalDevice;
       }
 
-      if (selectedDevice == VK_NULL_HANDLE)
-         selectedDevice = physicalDevices[0];
+      if (m_physicalDevice == VK_NULL_HANDLE)
+         m_physicalDevice = physicalDevices[0];
+   }
+}
+
+void VulkanRenderer::createDevice()
+{
+   YX_PROFILE_SCOPE("VulkanRenderer::createDevice");
+   // the window picked its kind of surface after the instance was created
+   auto requiredExtensions = Window::getRequiredInstanceExtensions();
+   if (not Window::isHeadless())
+      requiredExtensions.emplace_back("VK_KHR_get_surface_capabilities2");
+   for (const char* extension : requiredExtensions)
+   {
+      if (std::none_of(m_instanceExtensions.begin(), m_instanceExtensions.end(), [extension](const char* enabled) { return std::strcmp(enabled, extension) == 0; }))
+         throw std::runtime_error(fmt::format("Vulkan instance is missing the surface extension {}", extension));
    }
-   
-   m_device = std::make_unique<Device>(selectedDevice);
+
+   Window::createSurface(m_instance);
+   m_device = std::make_unique<Device>(m_physicalDevice);
+   VkResult result;
+
+   {
+      const VkCommandPoolCreateInfo commandPoolCreateInfo =
+      {
+         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+         .pNext = nullptr,
+         .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+         .queueFamilyIndex = m_device->getDeviceQueues().graphics.familyIndex,
+      };
+
+      result = vkCreateCommandPool(*m_device, &commandPoolCreateInfo, nullptr, &m_commandPool);
+      if (result != VK_SUCCESS)
+         throw std::runtime_error(fmt::format("Couldn't create frame command pool. {}", string_VkResult(result)));
+
+      const VkCommandBufferAllocateInfo allocateInfo =
+      {
+         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+         .pNext = nullptr,
+         .commandPool = m_commandPool,
+         .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+         .commandBufferCount = FRAMES_IN_FLIGHT,
+      };
+
+      result = vkAllocateCommandBuffers(*m_device, &allocateInfo, m_commandBuffers.data());
+      if (result != VK_SUCCESS)
+         throw std::runtime_error(fmt::format("Couldn't allocate frame command buffers. {}", string_VkResult(result)));
+
+      m_frameTimeline = std::make_unique<TimelineSemaphore>(m_device.get(), 0);
+      m_frameNumber = 0;
+
+      if (m_device->getSwapchain())
+      {
+         for (auto& semaphore : m_acquireSemaphores)
+            semaphore = createBinarySemaphore(*m_device);
+         createPresentSemaphores();
+      }
+   }
+}
+
+void VulkanRenderer::createPipelineCache(const std::string& path, const std::span<const std::byte> initialData)
+{
+   YX_PROFILE_SCOPE("VulkanRenderer::createPipelineCache");
+   m_pipelineCache = std::make_unique<PipelineCache>(m_device.get(), initialData);
+   m_pipelineCachePath = path;
+}
+
+void VulkanRenderer::createPresentSemaphores()
+{
+   m_presentSemaphores.resize(m_device->getSwapchain()->getImageCount());
+   for (auto& semaphore : m_presentSemaphores)
+      semaphore = createBinarySemaphore(*m_device);
+}
+
+void VulkanRenderer::destroyPresentSemaphores()
+{
+   for (const auto semaphore : m_presentSemaphores)
+      vkDestroySemaphore(*m_device, semaphore, nullptr);
+   m_presentSemaphores.clear();
+}
+
+void VulkanRenderer::recreateSwapchain(const VkExtent2D extent)
+{
+   // out of date while minimized, the main loop stops rendering until the window comes back
+   if (extent.width == 0 || extent.height == 0)
+      return;
+
+   vkDeviceWaitIdle(*m_device);
+   m_device->getSwapchain()->recreate(extent);
+   destroyPresentSemaphores();
+   createPresentSemaphores();
+}
+
+void VulkanRenderer::renderFrame(const FramePacket& frame)
+{
+   YX_PROFILE_SCOPE("VulkanRenderer::renderFrame");
+   // the slot's command buffer and acquire semaphore are free again once the frame that last used them retired
+   if (m_frameNumber >= FRAMES_IN_FLIGHT)
+      m_frameTimeline->wait(m_frameNumber - FRAMES_IN_FLIGHT + 1);
+   // reads back the timestamps of frame m_frameNumber - GpuProfiler::FRAME_COUNT, retired by now
+   m_device->getGpuProfiler().beginFrame(m_frameNumber);
+
+   const uint32_t frameSlot = static_cast<uint32_t>(m_frameNumber % FRAMES_IN_FLIGHT);
+   Swapchain* swapchain = m_device->getSwapchain();
+
+   VkImage image;
+   uint32_t imageIndex = 0;
+   if (swapchain)
+   {
+      if (not swapchain->acquireNextImage(m_acquireSemaphores[frameSlot], imageIndex))
+      {
+         recreateSwapchain(frame.drawableExtent);
+         return;
+      }
+      image = swapchain->getImage(imageIndex);
+   }
+   else
+   {
+      const OffscreenTarget* target = m_device->getOffscreenTarget();
+      image = target->getImage(static_cast<uint32_t>(m_frameNumber % target->getImageCount()));
+   }
+
+   const VkCommandBuffer commandBuffer = m_commandBuffers[frameSlot];
+   const VkImageSubresourceRange subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+   vkResetCommandBuffer(commandBuffer, 0);
+   const VkCommandBufferBeginInfo beginInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .pNext = nullptr,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+      .pInheritanceInfo = nullptr,
+   };
+   vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+   auto transitionImage = [&](const VkImageLayout oldLayout, const VkImageLayout newLayout,
+      const VkPipelineStageFlags2 srcStage, const VkAccessFlags2 srcAccess, const VkPipelineStageFlags2 dstStage, const VkAccessFlags2 dstAccess) {
+      const VkImageMemoryBarrier2 barrier =
+      {
+         .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+         .pNext = nullptr,
+         .srcStageMask = srcStage,
+         .srcAccessMask = srcAccess,
+         .dstStageMask = dstStage,
+         .dstAccessMask = dstAccess,
+         .oldLayout = oldLayout,
+         .newLayout = newLayout,
+         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .image = image,
+         .subresourceRange = subresourceRange,
+      };
+      const VkDependencyInfo dependencyInfo =
+      {
+         .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+         .pNext = nullptr,
+         .dependencyFlags = 0,
+         .imageMemoryBarrierCount = 1,
+         .pImageMemoryBarriers = &barrier,
+      };
+      vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+   };
+
+   {
+      YX_GPU_PROFILE_SCOPE(m_device->getGpuProfiler(), commandBuffer, m_device->getDeviceQueues().graphics.familyIndex, "Frame");
+
+      // the source stage covers the previous clear of this image and the acquire semaphore wait
+      transitionImage(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+         VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+      // nothing is drawn yet, the clear stands in for the frame
+      const VkClearColorValue clearColor = { { 0.05f, 0.05f, 0.05f, 1.0f } };
+      vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &subresourceRange);
+
+      if (swapchain)
+         transitionImage(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE);
+   }
+
+   VkResult result = vkEndCommandBuffer(commandBuffer);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to record frame {}. {}", m_frameNumber, string_VkResult(result)));
+
+   const VkCommandBufferSubmitInfo commandBufferInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .pNext = nullptr,
+      .commandBuffer = commandBuffer,
+      .deviceMask = 0,
+   };
+   const VkSemaphoreSubmitInfo waitInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+      .pNext = nullptr,
+      .semaphore = m_acquireSemaphores[frameSlot],
+      .value = 0,
+      .stageMask = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+      .deviceIndex = 0,
+   };
+   const std::array<VkSemaphoreSubmitInfo, 2> signalInfos =
+   { {
+      {
+         .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+         .pNext = nullptr,
+         .semaphore = *m_frameTimeline,
+         .value = m_frameNumber + 1,
+         .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+         .deviceIndex = 0,
+      },
+      {
+         .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+         .pNext = nullptr,
+         .semaphore = swapchain ? m_presentSemaphores[imageIndex] : VK_NULL_HANDLE,
+         .value = 0,
+         .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+         .deviceIndex = 0,
+      },
+   } };
+   const VkSubmitInfo2 submitInfo =
+   {
+      .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+      .pNext = nullptr,
+      .flags = 0,
+      .waitSemaphoreInfoCount = swapchain ? 1u : 0u,
+      .pWaitSemaphoreInfos = &waitInfo,
+      .commandBufferInfoCount = 1,
+      .pCommandBufferInfos = &commandBufferInfo,
+      .signalSemaphoreInfoCount = swapchain ? 2u : 1u,
+      .pSignalSemaphoreInfos = signalInfos.data(),
+   };
+
+   const VkQueue queue = m_device->getDeviceQueues().graphics.queues[0];
+   result = vkQueueSubmit2(queue, 1, &submitInfo, VK_NULL_HANDLE);
+   if (result != VK_SUCCESS)
+      throw std::runtime_error(fmt::format("Failed to submit frame {}. {}", m_frameNumber, string_VkResult(result)));
+
+   m_frameNumber++;
+
+   if (swapchain && not swapchain->present(queue, imageIndex, m_presentSemaphores[imageIndex]))
+      recreateSwapchain(frame.drawableExtent);
 }
 
 const std::string& VulkanRenderer::getAppName()
@@ -163,8 +483,48 @@ const VulkanRenderer::DevicePtr& VulkanRenderer::getDevice()
    return m_device;
 }
 
+const VkPipelineCache VulkanRenderer::getPipelineCache()
+{
+   return m_pipelineCache ? static_cast<VkPipelineCache>(*m_pipelineCache) : VK_NULL_HANDLE;
+}
+
+void VulkanRenderer::endFrame()
+{
+#ifdef YX_DEBUG
+   s_validationFilter.endFrame();
+#endif
+}
+
+void VulkanRenderer::dumpValidationSummary()
+{
+#ifdef YX_DEBUG
+   s_validationFilter.dumpPerformanceSummary();
+   s_validationFilter.dumpStatistics();
+#endif
+}
+
 void VulkanRenderer::destroy()
 {
+   YX_PROFILE_SCOPE("VulkanRenderer::destroy");
+   dumpValidationSummary();
+   if (m_device)
+   {
+      vkDeviceWaitIdle(*m_device);
+      if (m_pipelineCache)
+         m_pipelineCache->save(m_pipelineCachePath);
+      m_pipelineCache.reset();
+      m_frameTimeline.reset();
+      for (auto& semaphore : m_acquireSemaphores)
+      {
+         if (semaphore != VK_NULL_HANDLE)
+            vkDestroySemaphore(*m_device, semaphore, nullptr);
+         semaphore = VK_NULL_HANDLE;
+      }
+      destroyPresentSemaphores();
+      if (m_commandPool != VK_NULL_HANDLE)
+         vkDestroyCommandPool(*m_device, m_commandPool, nullptr);
+      m_commandPool = VK_NULL_HANDLE;
+   }
    m_device.reset();
 #ifdef YX_DEBUG
    if (m_debugMessenger != VK_NULL_HANDLE)
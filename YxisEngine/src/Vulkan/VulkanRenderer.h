@@ -1,26 +1,71 @@
 #pragma once
 
 #include "Device.h"
+#include "PipelineCache.h"
 
 namespace Yxis::Vulkan
 {
+	// what the main thread hands over to the render thread for one frame
+	struct FramePacket
+	{
+		uint64_t frameNumber;
+		// window size when the frame was simulated, the render thread doesn't touch SDL
+		VkExtent2D drawableExtent;
+	};
+
 	class VulkanRenderer
 	{
 	public:
 		using DevicePtr = std::unique_ptr<Device>;
 
-		static void initialize(const std::string& appName);
+		// startup is split so Application can overlap it with SDL, see Application::startup
+		// instance and physical device, touches no SDL state and can run on a job
+		static void createInstance(const std::string& appName, const bool headless);
+		// surface, device and frame resources, once the window exists
+		static void createDevice();
+		// initialData from PipelineCache::load, written back to path on destroy
+		static void createPipelineCache(const std::string& path, const std::span<const std::byte> initialData);
 		static void destroy();
 
+		// records and submits one frame and presents it when there's a swapchain
+		// blocks while FRAMES_IN_FLIGHT frames are still on the gpu
+		static void renderFrame(const FramePacket& frame);
+
+		// frame boundary for per-frame diagnostics
+		static void endFrame();
+		// logs the last frame's performance warnings and validation message counters (debug builds)
+		// the filter locks, so any thread may call it, Application::dumpValidationSummary forwards here
+		static void dumpValidationSummary();
+
 		static const std::string& getAppName();
 		static const VkInstance getInstance();
 		static const DevicePtr& getDevice();
+		static const VkPipelineCache getPipelineCache();
 	private:
 		static std::string m_appName;
 		static VkInstance m_instance;
 #ifdef YX_DEBUG
 		static VkDebugUtilsMessengerEXT m_debugMessenger;
 #endif
+		// every surface extension the loader offers, checked against the window's in createDevice
+		static std::vector<const char*> m_instanceExtensions;
+		static VkPhysicalDevice m_physicalDevice;
 		static DevicePtr m_device;
+		static std::unique_ptr<PipelineCache> m_pipelineCache;
+		static std::string m_pipelineCachePath;
+
+		static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+		static VkCommandPool m_commandPool;
+		static std::array<VkCommandBuffer, FRAMES_IN_FLIGHT> m_commandBuffers;
+		// counts completed frames, frame n signals n + 1
+		static std::unique_ptr<TimelineSemaphore> m_frameTimeline;
+		static uint64_t m_frameNumber;
+		// binary semaphores for the swapchain, acquire per frame slot and present per swapchain image
+		static std::array<VkSemaphore, FRAMES_IN_FLIGHT> m_acquireSemaphores;
+		static std::vector<VkSemaphore> m_presentSemaphores;
+
+		static void createPresentSemaphores();
+		static void destroyPresentSemaphores();
+		static void recreateSwapchain(const VkExtent2D extent);
 	};
 }
\ No newline at end of file
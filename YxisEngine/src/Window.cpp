@@ -1,5 +1,7 @@
 #include "Window.h"
 #include <Yxis/Logger.h>
+#include <Yxis/CommandLine.h>
+#include <charconv>
 #include <vector>
 #include <cassert>
 #include <algorithm>
@@ -7,16 +9,65 @@
 namespace Yxis
 {
    bool Window::s_windowInitialized = false;
+   bool Window::s_headless = false;
+   bool Window::s_headlessSurface = false;
+   VkExtent2D Window::s_headlessExtent = { 1920, 1080 };
    Window::WindowPtr Window::s_windowHandle = nullptr;
    VkSurfaceKHR Window::s_surface = VK_NULL_HANDLE;
 
-   void Window::initialize(const std::string_view title)
+   // --headless-extent=<width>x<height>
+   static VkExtent2D parseHeadlessExtent(const VkExtent2D defaultExtent)
+   {
+      const auto option = CommandLine::getOption("headless-extent");
+      if (not option)
+         return defaultExtent;
+
+      VkExtent2D extent;
+      const char* end = option->data() + option->size();
+      auto [separator, error] = std::from_chars(option->data(), end, extent.width);
+      if (error != std::errc() || separator == end || *separator != 'x'
+         || std::from_chars(separator + 1, end, extent.height).ec != std::errc()
+         || extent.width == 0 || extent.height == 0)
+         throw std::runtime_error(fmt::format("Invalid headless extent \"{}\", expected <width>x<height>", option.value()));
+
+      return extent;
+   }
+
+   void Window::initialize(const std::string_view title, const bool headless)
    {
       if (s_windowInitialized) return;
 
-      SDL_Init(SDL_INIT_VIDEO);
+      s_headlessExtent = parseHeadlessExtent(s_headlessExtent);
+
+      // no window either way, only the event loop is needed
+      auto initializeWithoutWindow = []() {
+         if (not SDL_Init(SDL_INIT_EVENTS))
+            throw std::runtime_error(fmt::format("Failed to initialize SDL events. {}", SDL_GetError()));
+         s_windowInitialized = true;
+      };
+
+      if (headless)
+      {
+         YX_CORE_LOGGER->info("Running headless, no window will be created");
+         s_headless = true;
+         initializeWithoutWindow();
+         return;
+      }
+
       int32_t displaysCount = 0;
-      const SDL_DisplayID* displays = SDL_GetDisplays(&displaysCount);
+      const SDL_DisplayID* displays = nullptr;
+      if (not CommandLine::hasOption("headless-surface") && SDL_Init(SDL_INIT_VIDEO))
+         displays = SDL_GetDisplays(&displaysCount);
+
+      if (displaysCount == 0)
+      {
+         YX_CORE_LOGGER->warn("No display available, presenting to a headless surface ({}x{})", s_headlessExtent.width, s_headlessExtent.height);
+         if (SDL_WasInit(SDL_INIT_VIDEO))
+            SDL_QuitSubSystem(SDL_INIT_VIDEO);
+         s_headlessSurface = true;
+         initializeWithoutWindow();
+         return;
+      }
       std::vector<const SDL_DisplayMode*> displayModes;
 
       for (int32_t i = 0; i < displaysCount; i++)
@@ -37,8 +88,33 @@ namespace Yxis
       s_windowInitialized = true;
    }
 
+   bool Window::isHeadless()
+   {
+      return s_headless;
+   }
+
+   bool Window::usesHeadlessSurface()
+   {
+      return s_headlessSurface;
+   }
+
+   const VkExtent2D Window::getExtent()
+   {
+      if (not s_windowHandle)
+         return s_headlessExtent;
+
+      int32_t width = 0, height = 0;
+      SDL_GetWindowSizeInPixels(s_windowHandle.get(), &width, &height);
+      return { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+   }
+
    const std::vector<const char*> Window::getRequiredInstanceExtensions()
    {
+      if (s_headless)
+         return {};
+      if (s_headlessSurface)
+         return { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+
       uint32_t extensionsCount;
       SDL_Vulkan_GetInstanceExtensions(&extensionsCount);
       std::vector<const char*> requiredExtensions(extensionsCount);
@@ -48,6 +124,24 @@ namespace Yxis
 
    const VkSurfaceKHR Window::createSurface(const VkInstance instance)
    {
+      if (s_headless)
+         return VK_NULL_HANDLE;
+
+      if (s_headlessSurface)
+      {
+         const VkHeadlessSurfaceCreateInfoEXT createInfo =
+         {
+            .sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT,
+            .pNext = nullptr,
+            .flags = 0,
+         };
+
+         VkResult result = vkCreateHeadlessSurfaceEXT(instance, &createInfo, nullptr, &s_surface);
+         if (result != VK_SUCCESS)
+            throw std::runtime_error(fmt::format("Failed to create headless surface. {}", string_VkResult(result)));
+         return s_surface;
+      }
+
       if (not SDL_Vulkan_CreateSurface(s_windowHandle.get(), instance, nullptr, &s_surface))
          throw std::runtime_error("Failed to create surface");
 
@@ -62,8 +156,28 @@ namespace Yxis
 
    void Window::destroySurface(const VkInstance instance)
    {
+      if (s_headless)
+         return;
+
       assert(s_surface != VK_NULL_HANDLE && "Surface wasn't initialized");
-      SDL_Vulkan_DestroySurface(instance, s_surface, nullptr);
+      if (s_headlessSurface)
+         vkDestroySurfaceKHR(instance, s_surface, nullptr);
+      else
+         SDL_Vulkan_DestroySurface(instance, s_surface, nullptr);
+   }
+
+   bool Window::isPresentable()
+   {
+      if (not s_windowHandle)
+         return true;
+
+      const SDL_WindowFlags flags = SDL_GetWindowFlags(s_windowHandle.get());
+      if (flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_OCCLUDED | SDL_WINDOW_HIDDEN))
+         return false;
+
+      int32_t width = 0, height = 0;
+      SDL_GetWindowSizeInPixels(s_windowHandle.get(), &width, &height);
+      return width > 0 && height > 0;
    }
 
    Window::~Window()
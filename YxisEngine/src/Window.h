@@ -21,14 +21,25 @@ namespace Yxis
       
       ~Window();
 
-      static void initialize(const std::string_view title);
+      // headless skips the window entirely, only the SDL event subsystem is initialized
+      static void initialize(const std::string_view title, const bool headless = false);
+      static bool isHeadless();
+      // no display was found, presentation goes to a VK_EXT_headless_surface instead (--headless-surface forces it)
+      static bool usesHeadlessSurface();
+      // drawable size in pixels, --headless-extent=<width>x<height> when there's no window
+      static const VkExtent2D getExtent();
       static const std::vector<const char*> getRequiredInstanceExtensions();
       static const VkSurfaceKHR createSurface(const VkInstance instance);
       static const VkSurfaceKHR getSurface();
       static void destroySurface(const VkInstance instance);
+      // false while the window is minimized, occluded, hidden or has a zero sized drawable
+      static bool isPresentable();
    private:
       static VkSurfaceKHR s_surface;
       static bool s_windowInitialized;
+      static bool s_headless;
+      static bool s_headlessSurface;
+      static VkExtent2D s_headlessExtent;
       static WindowPtr s_windowHandle;
    };
 }
\ No newline at end of file
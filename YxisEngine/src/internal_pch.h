@@ -6,9 +6,11 @@
 
 #include "Vulkan/vk_enum_string_helper.h"
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <optional>
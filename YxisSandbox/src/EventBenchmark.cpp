@@ -0,0 +1,155 @@
+#include "EventBenchmark.h"
+#include <yxis.h>
+#include <Yxis/Events/EventDispatcher.h>
+#include <Yxis/CommandLine.h>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+// Counts operator new calls of the calling thread. The replacement covers the engine too where global
+// operators are shared across modules (ELF shared libraries), not allocations made inside a Windows DLL.
+static thread_local uint64_t t_allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+   t_allocationCount++;
+   if (void* memory = std::malloc(size != 0 ? size : 1))
+      return memory;
+   throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+   std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+   std::free(memory);
+}
+
+// event ids are keyed by type name, so these can't live in an anonymous namespace
+namespace EventBenchmark
+{
+   class BenchmarkEvent : public Yxis::Events::IEvent
+   {
+   public:
+      BenchmarkEvent(uint64_t value) : value(value) { }
+
+      uint64_t value;
+   };
+
+   class PostedBenchmarkEvent : public Yxis::Events::IEvent
+   {
+   public:
+      PostedBenchmarkEvent(uint32_t producer, uint32_t sequence) : producer(producer), sequence(sequence) { }
+
+      uint32_t producer;
+      uint32_t sequence;
+   };
+}
+
+static constexpr uint32_t HANDLER_COUNT = 8;
+static constexpr uint32_t DISPATCH_COUNT = 1'000'000;
+
+void RunEventBenchmark()
+{
+   using Yxis::Events::EventDispatcher;
+
+   uint64_t sum = 0;
+   uint64_t* target = &sum;
+   std::array<Yxis::Events::SubscriptionHandle, HANDLER_COUNT> handles;
+   auto subscribeAll = [&]() {
+      for (auto& handle : handles)
+         handle = EventDispatcher::subscribe<EventBenchmark::BenchmarkEvent>([target](const EventBenchmark::BenchmarkEvent& event) { *target += event.value; });
+   };
+
+   // the first subscriptions grow the handler lists and register the type, re-subscribing reuses both
+   subscribeAll();
+   for (const auto& handle : handles)
+      EventDispatcher::unsubscribe(handle);
+
+   uint64_t allocations = t_allocationCount;
+   subscribeAll();
+   const uint64_t subscribeAllocations = t_allocationCount - allocations;
+
+   allocations = t_allocationCount;
+   const auto start = Clock::now();
+   for (uint32_t i = 0; i < DISPATCH_COUNT; i++)
+      EventDispatcher::dispatch(EventBenchmark::BenchmarkEvent(i));
+   const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+   const uint64_t dispatchAllocations = t_allocationCount - allocations;
+
+   for (const auto& handle : handles)
+      EventDispatcher::unsubscribe(handle);
+
+   const uint64_t expected = uint64_t(HANDLER_COUNT) * (uint64_t(DISPATCH_COUNT) * (DISPATCH_COUNT - 1) / 2);
+   if (sum != expected)
+      YX_CLIENT_ERROR("Event benchmark: handlers saw {} instead of {}", sum, expected);
+
+   YX_CLIENT_INFO("Event dispatch to {} handlers: {:.1f} ns/dispatch, {:.2f} ns/handler", HANDLER_COUNT, seconds / DISPATCH_COUNT * 1e9, seconds / DISPATCH_COUNT / HANDLER_COUNT * 1e9);
+   YX_CLIENT_INFO("Event allocations: {} for {} subscriptions, {} for {} dispatches", subscribeAllocations, HANDLER_COUNT, dispatchAllocations, DISPATCH_COUNT);
+   if (subscribeAllocations != 0 || dispatchAllocations != 0)
+      YX_CLIENT_WARN("Event dispatch isn't allocation free");
+}
+
+static constexpr uint32_t DEFAULT_PRODUCER_COUNT = 4;
+static constexpr uint32_t EVENTS_PER_PRODUCER = 250'000;
+
+void RunPostBenchmark()
+{
+   using Yxis::Events::EventDispatcher;
+
+   uint32_t producerCount = DEFAULT_PRODUCER_COUNT;
+   if (const auto option = Yxis::CommandLine::getOption("producers"))
+      std::from_chars(option->data(), option->data() + option->size(), producerCount);
+   producerCount = std::max(producerCount, 1u);
+
+   struct Deliveries
+   {
+      std::vector<uint8_t> counts;
+      uint64_t total = 0;
+   } deliveries;
+   deliveries.counts.resize(size_t(producerCount) * EVENTS_PER_PRODUCER);
+   const uint64_t expected = deliveries.counts.size();
+
+   Deliveries* target = &deliveries;
+   const auto handle = EventDispatcher::subscribe<EventBenchmark::PostedBenchmarkEvent>([target](const EventBenchmark::PostedBenchmarkEvent& event) {
+      uint8_t& count = target->counts[size_t(event.producer) * EVENTS_PER_PRODUCER + event.sequence];
+      count = static_cast<uint8_t>(std::min(count + 1, 2));
+      target->total++;
+   });
+
+   std::atomic<uint32_t> running = producerCount;
+   std::vector<std::thread> producers;
+   const auto start = Clock::now();
+   for (uint32_t producer = 0; producer < producerCount; producer++)
+   {
+      producers.emplace_back([producer, &running]() {
+         for (uint32_t sequence = 0; sequence < EVENTS_PER_PRODUCER; sequence++)
+            EventDispatcher::post(EventBenchmark::PostedBenchmarkEvent(producer, sequence));
+         running.fetch_sub(1, std::memory_order_release);
+      });
+   }
+
+   // flushes while producers post, like the frame loop would. once they're done one more flush picks up the rest
+   while (running.load(std::memory_order_acquire) != 0)
+      EventDispatcher::flush();
+   EventDispatcher::flush();
+   const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+   for (auto& thread : producers)
+      thread.join();
+   EventDispatcher::unsubscribe(handle);
+
+   const uint64_t missing = std::count(deliveries.counts.begin(), deliveries.counts.end(), uint8_t(0));
+   const uint64_t duplicated = std::count(deliveries.counts.begin(), deliveries.counts.end(), uint8_t(2));
+   YX_CLIENT_INFO("Posted {} events from {} producers: {:.1f} M events/s, {:.1f} ns/event", deliveries.total, producerCount, expected / seconds / 1e6, seconds / expected * 1e9);
+   if (missing != 0 || duplicated != 0 || deliveries.total != expected)
+      YX_CLIENT_ERROR("Post benchmark: {} events missing, {} delivered more than once", missing, duplicated);
+}
\ No newline at end of file
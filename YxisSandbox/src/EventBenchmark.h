@@ -0,0 +1,9 @@
+#pragma once
+
+// event dispatch cost and allocations: subscribe and dispatch on the main thread, results go to the client log
+// YxisSandbox --event-benchmark --headless --max-frames=1
+void RunEventBenchmark();
+
+// cross-thread posting: producer threads post while the main thread flushes, checks every event arrives exactly once
+// YxisSandbox --post-benchmark [--producers=<n>] --headless --max-frames=1
+void RunPostBenchmark();
\ No newline at end of file
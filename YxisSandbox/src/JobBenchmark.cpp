@@ -0,0 +1,69 @@
+#include "JobBenchmark.h"
+#include <yxis.h>
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t REPETITIONS = 5;
+
+// best of REPETITIONS, in seconds
+template <typename Function>
+static double Measure(Function&& function)
+{
+   double best = std::numeric_limits<double>::max();
+   for (uint32_t i = 0; i < REPETITIONS; i++)
+   {
+      const auto start = Clock::now();
+      function();
+      best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+   }
+   return best;
+}
+
+static void BenchmarkEmptyJobs()
+{
+   constexpr uint32_t BATCH_SIZE = 1024;
+   constexpr uint32_t BATCH_COUNT = 1024;
+   constexpr double JOB_COUNT = double(BATCH_SIZE) * BATCH_COUNT;
+
+   const double seconds = Measure([]() {
+      for (uint32_t batch = 0; batch < BATCH_COUNT; batch++)
+      {
+         Yxis::JobCounter counter;
+         for (uint32_t i = 0; i < BATCH_SIZE; i++)
+            Yxis::JobSystem::run([]() {}, &counter);
+         Yxis::JobSystem::wait(counter);
+      }
+   });
+
+   YX_CLIENT_INFO("Empty jobs: {:.1f} M jobs/s, {:.1f} ns/job", JOB_COUNT / seconds / 1e6, seconds / JOB_COUNT * 1e9);
+}
+
+static void BenchmarkParallelFor()
+{
+   constexpr size_t ELEMENT_COUNT = 16 * 1024 * 1024;
+   std::vector<float> values(ELEMENT_COUNT, 1.0f);
+   float* data = values.data();
+
+   const double serial = Measure([data]() {
+      for (size_t i = 0; i < ELEMENT_COUNT; i++)
+         data[i] = data[i] * 0.999f + 0.5f;
+   });
+   YX_CLIENT_INFO("Serial loop: {:.0f} M it/s", ELEMENT_COUNT / serial / 1e6);
+
+   // fine grained: one multiply-add per index, only the chunking keeps the overhead down
+   for (const size_t minChunkSize : { size_t(1), size_t(256), size_t(4096) })
+   {
+      const double seconds = Measure([data, minChunkSize]() {
+         Yxis::JobSystem::parallelFor(0, ELEMENT_COUNT, [data](const size_t i) { data[i] = data[i] * 0.999f + 0.5f; }, minChunkSize);
+      });
+      YX_CLIENT_INFO("parallelFor (min chunk {}): {:.0f} M it/s, {:.2f}x serial", minChunkSize, ELEMENT_COUNT / seconds / 1e6, serial / seconds);
+   }
+}
+
+void RunJobBenchmark()
+{
+   YX_CLIENT_INFO("Job benchmark on {} workers, best of {}", Yxis::JobSystem::getWorkerCount(), REPETITIONS);
+   BenchmarkEmptyJobs();
+   BenchmarkParallelFor();
+}
\ No newline at end of file
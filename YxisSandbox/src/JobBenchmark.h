@@ -0,0 +1,5 @@
+#pragma once
+
+// job system throughput: empty jobs and a fine-grained parallelFor, results go to the client log
+// YxisSandbox --job-benchmark [--job-workers=<n>] [--pin-workers] --headless --max-frames=1
+void RunJobBenchmark();
\ No newline at end of file
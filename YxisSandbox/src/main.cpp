@@ -2,30 +2,56 @@
 #include <Yxis/Events/IEvent.h>
 #include <Yxis/Events/IKeyboardEvent.h>
 #include <Yxis/Events/EventDispatcher.h>
+#include <Yxis/CommandLine.h>
+#include "JobBenchmark.h"
+#include "EventBenchmark.h"
 #include <iostream>
 
+// starts and stops a profiler capture
+static constexpr uint32_t PROFILER_CAPTURE_KEY = Yxis::KEY_F9;
+// logs the renderer's validation summary
+static constexpr uint32_t VALIDATION_SUMMARY_KEY = Yxis::KEY_F10;
+
 class SandboxApplication : public Yxis::Application
 {
 public:
    SandboxApplication() : Application("SandboxApplication")
    {
       // do some code on initialization
-      Yxis::Events::EventDispatcher::subscribe<Yxis::Events::IKeyboardEvent>(std::bind(&SandboxApplication::KeyboardHandler, this, std::placeholders::_1));
+      Yxis::Events::EventDispatcher::subscribe<Yxis::Events::IKeyboardEvent, &SandboxApplication::KeyboardHandler>(this);
+
+      if (Yxis::CommandLine::hasOption("job-benchmark"))
+         RunJobBenchmark();
+      if (Yxis::CommandLine::hasOption("event-benchmark"))
+         RunEventBenchmark();
+      if (Yxis::CommandLine::hasOption("post-benchmark"))
+         RunPostBenchmark();
    }
 
-   void KeyboardHandler(const std::shared_ptr<Yxis::Events::IEvent>& e)
+   void KeyboardHandler(const Yxis::Events::IKeyboardEvent& e)
    {
-      Yxis::Events::IKeyboardEvent* kbEv = static_cast<Yxis::Events::IKeyboardEvent*>(e.get());
-      
-      YX_CLIENT_LOGGER->info("{} has been pressed.", kbEv->key);
-      if (kbEv->key == 27)
+      YX_CLIENT_INFO("{} has been pressed.", e.key);
+      if (e.key == Yxis::KEY_ESCAPE)
          exit();
+
+      if (e.down && e.key == PROFILER_CAPTURE_KEY)
+      {
+         if (Yxis::Profiler::isCapturing())
+            Yxis::Profiler::endCapture();
+         else
+            Yxis::Profiler::beginCapture(fmt::format("capture_{}.json", m_captureCount++));
+      }
+
+      if (e.down && e.key == VALIDATION_SUMMARY_KEY)
+         dumpValidationSummary();
    }
 
    ~SandboxApplication()
    {
       // do some code on exit
    }
+private:
+   uint32_t m_captureCount = 0;
 };
 
 Yxis::Application* CreateApplication()